@@ -0,0 +1,115 @@
+//
+//  Attenuator.cpp
+//
+//  Step attenuator subsystem.  Replaces the old itoa() string based PE4302 bit-bang.
+//  The PE4302 write is a fixed 6 bit shift, MSB (16dB) first, then an LE pulse to latch.
+//  Every edge is separated by PE4302_T_NS so a write always takes the same time, about 4us at the default.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Attenuator.h"
+
+extern struct Band_Memory bandmem[];
+
+static const struct Step_Atten *atten_drv = NULL;
+static uint8_t  atten_code     = 0;     // last code written to the part
+static uint32_t atten_time_max = 0;     // longest write in CPU cycles
+
+#ifdef PE4302
+
+static void PE4302_Init(void)
+{
+    pinMode(Atten_LE,   OUTPUT);
+    pinMode(Atten_DATA, OUTPUT);
+    pinMode(Atten_CLK,  OUTPUT);
+    digitalWriteFast(Atten_LE,   LOW);
+    digitalWriteFast(Atten_DATA, LOW);
+    digitalWriteFast(Atten_CLK,  LOW);
+}
+
+// Datasheet serial sequence: LE low, for each bit MSB first set DATA then pulse CLK, then pulse LE to latch.
+static void PE4302_Write(uint8_t code)
+{
+    digitalWriteFast(Atten_LE,  LOW);
+    digitalWriteFast(Atten_CLK, LOW);
+
+    for (int8_t bit = PE4302_BITS - 1; bit >= 0; bit--)
+    {
+        digitalWriteFast(Atten_DATA, (code >> bit) & 1);
+        delayNanoseconds(PE4302_T_NS);      // data setup to clock rising
+        digitalWriteFast(Atten_CLK, HIGH);
+        delayNanoseconds(PE4302_T_NS);      // clock high
+        digitalWriteFast(Atten_CLK, LOW);
+        delayNanoseconds(PE4302_T_NS);      // clock low, also data hold
+    }
+
+    digitalWriteFast(Atten_LE, HIGH);       // latch, new attenuation takes effect
+    delayNanoseconds(PE4302_T_NS);
+    digitalWriteFast(Atten_LE, LOW);
+    digitalWriteFast(Atten_DATA, LOW);
+}
+
+const struct Step_Atten PE4302_Atten = { "PE4302", (1 << PE4302_BITS) - 1, 1, PE4302_Init, PE4302_Write };
+
+#else
+
+const struct Step_Atten PE4302_Atten = { "PE4302", 0, 1, NULL, NULL };  // not configured, Atten_Init() will ignore it
+
+#endif  // PE4302
+
+COLD void Atten_Init(const struct Step_Atten *drv)
+{
+    atten_drv = NULL;
+    if (drv == NULL || drv->init == NULL || drv->write == NULL)
+    {
+        DPRINTLNF("Atten_Init: No step attenuator configured");
+        return;
+    }
+    atten_drv = drv;
+    atten_drv->init();
+    atten_code = 0;
+    atten_drv->write(atten_code);
+    DPRINTF("Atten_Init: "); DPRINT(atten_drv->name); DPRINTF(" max "); DPRINT(atten_drv->max_code * atten_drv->half_dB_per_code / 2.0f); DPRINTLNF("dB");
+}
+
+void Atten_Set(uint8_t half_dB)
+{
+    uint8_t  code;
+    uint32_t start;
+
+    if (atten_drv == NULL)
+        return;
+
+    code = half_dB / atten_drv->half_dB_per_code;   // round down to what the part can do
+    if (code > atten_drv->max_code)
+        code = atten_drv->max_code;
+
+    start = ARM_DWT_CYCCNT;
+    atten_drv->write(code);
+    start = ARM_DWT_CYCCNT - start;
+    if (start > atten_time_max)
+        atten_time_max = start;
+
+    atten_code = code;
+    DPRINTF("Atten_Set: "); DPRINT(Atten_Get() / 2.0f); DPRINTF("dB  code "); DPRINT(code); DPRINTF("  cycles "); DPRINTLN(start);
+}
+
+uint8_t Atten_Get(void)
+{
+    if (atten_drv == NULL)
+        return 0;
+    return atten_code * atten_drv->half_dB_per_code;
+}
+
+// Called on band change
+void Atten_Band(uint8_t band)
+{
+    if (band < BANDS)
+        Atten_Set(bandmem[band].step_atten);
+}
+
+uint32_t Atten_Write_Time_Max(void)
+{
+    return atten_time_max;
+}
@@ -0,0 +1,32 @@
+#ifndef _ATTENUATOR_H_
+#define _ATTENUATOR_H_
+//
+//  Attenuator.h
+//
+//  External step attenuator control.  Levels are kept in 0.5dB units throughout so a 0.5dB part like the PE4302
+//  gets its full resolution.  Hardware is reached through a small driver struct so another part, or a PE4302
+//  behind an I2C port expander, only needs its own init and write functions.
+//
+#include <Arduino.h>
+
+// PE4302 serial timing from the datasheet is in the tens of ns.  Run well above that for long wires.
+#define PE4302_BITS         6       // C16 C8 C4 C2 C1 C0.5, shifted MSB first
+#define PE4302_T_NS         200     // data setup, clock high, clock low, LE setup and LE pulse width each get this long
+
+struct Step_Atten {
+    const char *name;
+    uint8_t     max_code;           // highest setting the part accepts
+    uint8_t     half_dB_per_code;   // 1 for 0.5dB parts, 2 for 1dB parts
+    void      (*init)(void);        // pin or bus setup, leaves the part at 0dB
+    void      (*write)(uint8_t code);
+};
+
+extern const struct Step_Atten PE4302_Atten;
+
+void    Atten_Init(const struct Step_Atten *drv);   // NULL = no attenuator fitted
+void    Atten_Set(uint8_t half_dB);                 // 0.5dB units, clamped to the part's range
+uint8_t Atten_Get(void);                            // 0.5dB units actually set
+void    Atten_Band(uint8_t band);                   // apply bandmem[band].step_atten
+uint32_t Atten_Write_Time_Max(void);                // longest write seen, CPU cycles
+
+#endif // _ATTENUATOR_H_
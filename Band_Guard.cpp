@@ -0,0 +1,186 @@
+//
+//  Band_Guard.cpp
+//
+//  Every band change comes in through changeBands(), Band_Select() or VFO_AB().  Each asks Band_Guard_Hold() first.
+//  While TX_Timer reports a keyed source (radio over CI-V, PTT_INPUT or the XMIT button), XMIT is on, or a band decode
+//  PTT output is keyed, the request is queued instead and the Band button shows it is pending.  Later requests replace
+//  the queued one, band up/down steps add up.
+//  Band_Guard_Service() replays the request once RX has held for BAND_GUARD_SETTLE_MS.
+//  Band_Guard_Override(), or BAND_GUARD_OVERRIDE 1, unkeys everything the way the TX timer does and keeps the PTT
+//  outputs in RX until the queued change is done.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Controls.h"
+#include "Display.h"
+#include "TX_Timer.h"
+#include "Band_Guard.h"
+#include "No_Heap.h"
+
+extern struct Standard_Button std_btn[];
+extern struct Band_Memory bandmem[];
+extern struct User_Settings user_settings[];
+extern uint8_t user_Profile;
+
+static uint8_t  bg_request  = BAND_GUARD_NONE;
+static int8_t   bg_arg      = 0;        // direction or band index
+static uint32_t bg_asked    = 0;        // millis() of the first queued request
+static uint32_t bg_rx_since = 0;        // millis() TX ended
+static bool     bg_tx       = false;    // TX seen on the last service pass
+static bool     bg_settling = false;    // in RX, waiting out BAND_GUARD_SETTLE_MS
+static bool     bg_forced   = false;    // RX forced for the queued request
+static bool     bg_ptt      = false;    // band decode PTT outputs keyed
+static bool     bg_applying = false;    // replaying the queued request
+static char     bg_label[sizeof(std_btn[0].label)];
+static struct Band_Guard_Stats bg_stats;
+
+static bool Band_Guard_TX(void)
+{
+    return TX_Timer_Keyed() || user_settings[user_Profile].xmit || bg_ptt;
+}
+
+static void Band_Guard_Alert(bool pending)
+{
+    if (pending)
+    {
+        strcpy(bg_label, std_btn[BAND_BTN].label);
+        snprintf(std_btn[BAND_BTN].label, sizeof(bg_label), "%.*s*", (int) sizeof(bg_label) - 2, bg_label);
+    }
+    else
+        strcpy(std_btn[BAND_BTN].label, bg_label);
+    displayBand();
+}
+
+bool Band_Guard_Hold(uint8_t request, int8_t arg)
+{
+    if (bg_applying || (bg_request == BAND_GUARD_NONE && !bg_settling && !Band_Guard_TX()))
+        return false;
+
+    if (bg_request == BAND_GUARD_NONE)
+    {
+        bg_asked = millis();
+        Band_Guard_Alert(true);
+    }
+
+    if (request == BAND_GUARD_STEP && bg_request == BAND_GUARD_STEP)
+        bg_arg += arg;
+    else if (request == BAND_GUARD_VFO_AB && bg_request == BAND_GUARD_VFO_AB)
+        request = BAND_GUARD_NONE;      // swapped back, nothing left to do
+    else
+        bg_arg = arg;
+    bg_request = request;
+    bg_stats.deferred++;
+
+    DPRINTF("Band_Guard_Hold: TX active, band change queued.  Request "); DPRINT(bg_request); DPRINTF("  Arg "); DPRINTLN(bg_arg);
+
+    if (bg_request == BAND_GUARD_NONE)
+        Band_Guard_Alert(false);
+    else if (BAND_GUARD_OVERRIDE)
+        Band_Guard_Override();
+    return true;
+}
+
+static void Band_Guard_Apply(void)
+{
+    uint8_t request = bg_request;
+
+    bg_request  = BAND_GUARD_NONE;
+    bg_applying = true;     // so the replayed call is not queued again
+    bg_stats.applied++;
+    bg_stats.last_wait_ms = millis() - bg_asked;
+    Band_Guard_Alert(false);
+    DPRINTF("Band_Guard_Apply: Band change after "); DPRINT(bg_stats.last_wait_ms); DPRINTLNF("ms");
+
+    switch (request)
+    {
+        case BAND_GUARD_STEP:   changeBands(bg_arg);    break;
+        case BAND_GUARD_SELECT: Band_Select(bg_arg);    break;
+        case BAND_GUARD_VFO_AB: VFO_AB();               break;
+    }
+    bg_applying = false;
+    bg_forced   = false;
+}
+
+PLACE(Band_Guard_Service) void Band_Guard_Service(void)
+{
+    PROF(Band_Guard_Service);
+    uint32_t now;
+
+    if (!bg_forced && Band_Guard_TX())
+    {
+        bg_tx       = true;
+        bg_settling = false;
+        return;
+    }
+
+    now = millis();
+    if (bg_tx)  // TX just ended, relays start dropping out now
+    {
+        bg_tx       = false;
+        bg_settling = true;
+        bg_rx_since = now;
+    }
+    if (bg_settling && (now - bg_rx_since) >= BAND_GUARD_SETTLE_MS)
+        bg_settling = false;
+    if (!bg_settling && bg_request != BAND_GUARD_NONE)
+        Band_Guard_Apply();
+}
+
+COLD void Band_Guard_Override(void)
+{
+    if (bg_request == BAND_GUARD_NONE || bg_forced)
+        return;
+    DPRINTLNF("Band_Guard_Override: Forcing RX for the queued band change");
+    bg_forced = true;       // PTT outputs stay in RX until the change is done
+    bg_stats.overrides++;
+    TX_Timer_Unkey();
+    bg_tx       = true;     // settle time starts on the next service pass
+    bg_settling = false;
+}
+
+void Band_Guard_Switch(uint8_t band)
+{
+    if (bg_ptt || user_settings[user_Profile].xmit)
+    {
+        bg_stats.keyed_switches++;
+        DPRINTF("Band_Guard_Switch: ***** Band decode changed with PTT keyed, band "); DPRINTLN(bandmem[band].band_name);
+    }
+}
+
+void Band_Guard_PTT(uint8_t state)
+{
+    bg_ptt = state;
+}
+
+bool Band_Guard_PTT_OK(void)
+{
+    return !bg_forced;
+}
+
+bool Band_Guard_Pending(void)
+{
+    return bg_request != BAND_GUARD_NONE;
+}
+
+const struct Band_Guard_Stats * Band_Guard_Get_Stats(void)
+{
+    return &bg_stats;
+}
+
+// Only when a request was queued, carried out or forced, or the outputs switched keyed
+COLD void Band_Guard_Show_Stats(void)
+{
+    static uint32_t last_sum = 0;
+    uint32_t sum = bg_stats.deferred + bg_stats.applied + bg_stats.overrides + bg_stats.keyed_switches;
+
+    if (sum == last_sum)
+        return;
+    last_sum = sum;
+
+    DPRINTF("Band_Guard: deferred="); DPRINT(bg_stats.deferred);
+    DPRINTF(" applied="); DPRINT(bg_stats.applied);
+    DPRINTF(" overrides="); DPRINT(bg_stats.overrides);
+    DPRINTF(" keyed_switches="); DPRINT(bg_stats.keyed_switches);
+    DPRINTF(" last_wait_ms="); DPRINTLN(bg_stats.last_wait_ms);
+}
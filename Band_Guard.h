@@ -0,0 +1,38 @@
+#ifndef _BAND_GUARD_H_
+#define _BAND_GUARD_H_
+//
+//  Band_Guard.h
+//
+//  TX safe band change.  A band change asked for while any TX source is keyed is queued and applied once the station
+//  is back in RX and BAND_GUARD_SETTLE_MS has passed, so the band decode outputs never switch relays under power.
+//  BAND_GUARD_OVERRIDE in RadioConfig.h selects waiting for the operator or forcing RX.
+//
+#include <Arduino.h>
+
+// What was asked for.  Replayed through the same function once it is safe.
+enum Band_Guard_Request {
+    BAND_GUARD_NONE,
+    BAND_GUARD_STEP,        // changeBands(direction), band up/down buttons and swipes
+    BAND_GUARD_SELECT,      // Band_Select(band), band menu and bandstack
+    BAND_GUARD_VFO_AB       // VFO_AB(), VFO B may be on another band
+};
+
+struct Band_Guard_Stats {
+    uint32_t deferred;          // requests queued because of TX
+    uint32_t applied;           // queued requests carried out
+    uint32_t overrides;         // times RX was forced for a queued request
+    uint32_t keyed_switches;    // band decode changes with a PTT output keyed.  Must stay 0
+    uint32_t last_wait_ms;      // request to band change for the last queued request
+};
+
+bool Band_Guard_Hold(uint8_t request, int8_t arg);  // true if the request was queued, the caller must return
+void Band_Guard_Service(void);                      // call every loop pass.  Applies a queued request when safe
+void Band_Guard_Override(void);                     // force RX now so a queued request goes after the settle time
+void Band_Guard_Switch(uint8_t band);               // changeBands() is about to drive the band decode outputs
+void Band_Guard_PTT(uint8_t state);                 // PTT_Output() reports the state it drove
+bool Band_Guard_PTT_OK(void);                       // false while RX is forced for a queued band change
+bool Band_Guard_Pending(void);
+const struct Band_Guard_Stats * Band_Guard_Get_Stats(void);
+void Band_Guard_Show_Stats(void);
+
+#endif // _BAND_GUARD_H_
@@ -0,0 +1,192 @@
+#ifndef _BAND_TABLE_H_
+#define _BAND_TABLE_H_
+//
+//  Band_Table.h
+//
+//  Band decoder tables built at compile time from the ENABLE_xxx_BAND, DECODE_xxx and BAND_DECODE_xxx_PIN
+//  settings in RadioConfig.h.  The output path is one indexed lookup per band change instead of a switch.
+//  The static_asserts at the bottom reject a RadioConfig.h edit that would drive two bands with the same pattern,
+//  drive an output onto a pin already used by an enabled switch or encoder, or need more bits than there are pins.
+//
+//  Band edges stay in bandmem[].  They are user editable and saved to SD so they cannot be compile time constants.
+//
+#include <Arduino.h>
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+
+#define BAND_DECODE_BITS    8       // output pattern is 1 byte, one pin per bit
+
+struct Band_Decode {
+    uint8_t band;                   // BAND160M ... BAND122G, also the row index
+    uint8_t enabled;                // ENABLE_xxx_BAND
+    uint8_t decode;                 // DECODE_BANDxxx pattern on the band decode pins
+    uint8_t decode_ptt;             // DECODE_BANDxxx_PTT pattern on the PTT breakout pins while transmitting
+};
+
+// One row per band, index = band number.  PAN_ADAPT has no row and gets no output.
+constexpr struct Band_Decode band_decode_table[] = {
+    { BAND160M, ENABLE_160M_BAND, DECODE_BAND160M,  DECODE_BAND160M_PTT  },
+    { BAND80M,  ENABLE_80M_BAND,  DECODE_BAND80M,   DECODE_BAND80M_PTT   },
+    { BAND60M,  ENABLE_60M_BAND,  DECODE_BAND60M,   DECODE_BAND60M_PTT   },
+    { BAND40M,  ENABLE_40M_BAND,  DECODE_BAND40M,   DECODE_BAND40M_PTT   },
+    { BAND30M,  ENABLE_30M_BAND,  DECODE_BAND30M,   DECODE_BAND30M_PTT   },
+    { BAND20M,  ENABLE_20M_BAND,  DECODE_BAND20M,   DECODE_BAND20M_PTT   },
+    { BAND17M,  ENABLE_17M_BAND,  DECODE_BAND17M,   DECODE_BAND17M_PTT   },
+    { BAND15M,  ENABLE_15M_BAND,  DECODE_BAND15M,   DECODE_BAND15M_PTT   },
+    { BAND12M,  ENABLE_12M_BAND,  DECODE_BAND12M,   DECODE_BAND12M_PTT   },
+    { BAND10M,  ENABLE_10M_BAND,  DECODE_BAND10M,   DECODE_BAND10M_PTT   },
+    { BAND6M,   ENABLE_6M_BAND,   DECODE_BAND6M,    DECODE_BAND6M_PTT    },
+    { BAND144,  ENABLE_144_BAND,  DECODE_BAND144,   DECODE_BAND144_PTT   },
+    { BAND222,  ENABLE_222_BAND,  DECODE_BAND222,   DECODE_BAND222_PTT   },
+    { BAND432,  ENABLE_432_BAND,  DECODE_BAND432,   DECODE_BAND432_PTT   },
+    { BAND902,  ENABLE_902_BAND,  DECODE_BAND902,   DECODE_BAND902_PTT   },
+    { BAND1296, ENABLE_1296_BAND, DECODE_BAND1296,  DECODE_BAND1296_PTT  },
+    { BAND2400, ENABLE_2400_BAND, DECODE_BAND2400,  DECODE_BAND2400_PTT  },
+    { BAND3400, ENABLE_3400_BAND, DECODE_BAND3400,  DECODE_BAND3400_PTT  },
+    { BAND5760, ENABLE_5760_BAND, DECODE_BAND5760,  DECODE_BAND5760_PTT  },
+    { BAND10G,  ENABLE_10G_BAND,  DECODE_BAND10G,   DECODE_BAND10G_PTT   },
+    { BAND24G,  ENABLE_24G_BAND,  DECODE_BAND24G,   DECODE_BAND24G_PTT   },
+    { BAND47G,  ENABLE_47G_BAND,  DECODE_BAND47G,   DECODE_BAND47G_PTT   },
+    { BAND76G,  ENABLE_76G_BAND,  DECODE_BAND76G,   DECODE_BAND76G_PTT   },
+    { BAND122G, ENABLE_122G_BAND, DECODE_BAND122G,  DECODE_BAND122G_PTT  }
+};
+
+#define BAND_DECODE_ROWS    (sizeof(band_decode_table)/sizeof(band_decode_table[0]))
+
+// Pin for each output bit, GPIO_PIN_NOT_USED if that bit is not wired
+constexpr uint8_t band_decode_pins[BAND_DECODE_BITS] = {
+    BAND_DECODE_OUTPUT_PIN_0, BAND_DECODE_OUTPUT_PIN_1, BAND_DECODE_OUTPUT_PIN_2, BAND_DECODE_OUTPUT_PIN_3,
+    BAND_DECODE_OUTPUT_PIN_4, BAND_DECODE_OUTPUT_PIN_5, BAND_DECODE_OUTPUT_PIN_6, BAND_DECODE_OUTPUT_PIN_7
+};
+
+constexpr uint8_t band_decode_ptt_pins[BAND_DECODE_BITS] = {
+    BAND_DECODE_PTT_OUTPUT_PIN_0, BAND_DECODE_PTT_OUTPUT_PIN_1, BAND_DECODE_PTT_OUTPUT_PIN_2, BAND_DECODE_PTT_OUTPUT_PIN_3,
+    BAND_DECODE_PTT_OUTPUT_PIN_4, BAND_DECODE_PTT_OUTPUT_PIN_5, BAND_DECODE_PTT_OUTPUT_PIN_6, BAND_DECODE_PTT_OUTPUT_PIN_7
+};
+
+// Pins claimed by inputs and other outputs in this build.  A disabled function releases its pin.
+constexpr uint8_t band_decode_reserved_pins[] = {
+    GPIO_VFO_ENABLE  ? GPIO_VFO_PIN_A   : GPIO_PIN_NOT_USED,
+    GPIO_VFO_ENABLE  ? GPIO_VFO_PIN_B   : GPIO_PIN_NOT_USED,
+    GPIO_ENC2_ENABLE ? GPIO_ENC2_PIN_A  : GPIO_PIN_NOT_USED,
+    GPIO_ENC2_ENABLE ? GPIO_ENC2_PIN_B  : GPIO_PIN_NOT_USED,
+    GPIO_ENC2_ENABLE ? GPIO_ENC2_PIN_SW : GPIO_PIN_NOT_USED,
+    GPIO_ENC3_ENABLE ? GPIO_ENC3_PIN_A  : GPIO_PIN_NOT_USED,
+    GPIO_ENC3_ENABLE ? GPIO_ENC3_PIN_B  : GPIO_PIN_NOT_USED,
+    GPIO_ENC3_ENABLE ? GPIO_ENC3_PIN_SW : GPIO_PIN_NOT_USED,
+    GPIO_SW1_ENABLE  ? GPIO_SW1_PIN     : GPIO_PIN_NOT_USED,
+    GPIO_SW2_ENABLE  ? GPIO_SW2_PIN     : GPIO_PIN_NOT_USED,
+    GPIO_SW3_ENABLE  ? GPIO_SW3_PIN     : GPIO_PIN_NOT_USED,
+    GPIO_SW4_ENABLE  ? GPIO_SW4_PIN     : GPIO_PIN_NOT_USED,
+    GPIO_SW5_ENABLE  ? GPIO_SW5_PIN     : GPIO_PIN_NOT_USED,
+    GPIO_SW6_ENABLE  ? GPIO_SW6_PIN     : GPIO_PIN_NOT_USED,
+    GPIO_ANT_ENABLE  ? GPIO_ANT_PIN     : GPIO_PIN_NOT_USED,
+    PTT_INPUT,
+    PTT_OUT1,
+    INTERLOCK_0_PIN,
+    INTERLOCK_1_PIN,
+    INTERLOCK_2_PIN,
+  #ifdef I2C_ENCODERS
+    I2C_INT_PIN,
+  #endif
+  #ifdef PE4302
+    Atten_CLK,
+    Atten_DATA,
+    Atten_LE,
+  #endif
+};
+
+// ---------------------------  compile time checks  ---------------------------------
+
+// Bit mask of the output bits that have a pin assigned
+constexpr uint8_t band_decode_pin_mask(const uint8_t *pins)
+{
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < BAND_DECODE_BITS; i++)
+        if (pins[i] != GPIO_PIN_NOT_USED)
+            mask |= (1 << i);
+    return mask;
+}
+
+constexpr bool band_decode_rows_in_order(void)
+{
+    for (uint8_t i = 0; i < BAND_DECODE_ROWS; i++)
+        if (band_decode_table[i].band != i)
+            return false;
+    return true;
+}
+
+// No two enabled bands may share an output pattern
+constexpr bool band_decode_codes_unique(bool ptt)
+{
+    for (uint8_t i = 0; i < BAND_DECODE_ROWS; i++)
+    {
+        if (!band_decode_table[i].enabled)
+            continue;
+        for (uint8_t j = i + 1; j < BAND_DECODE_ROWS; j++)
+        {
+            if (!band_decode_table[j].enabled)
+                continue;
+            if (ptt ? (band_decode_table[i].decode_ptt == band_decode_table[j].decode_ptt)
+                    : (band_decode_table[i].decode == band_decode_table[j].decode))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Every enabled band's pattern must fit in the bits that have pins
+constexpr bool band_decode_codes_fit(bool ptt)
+{
+    for (uint8_t i = 0; i < BAND_DECODE_ROWS; i++)
+    {
+        if (!band_decode_table[i].enabled)
+            continue;
+        if (ptt ? (band_decode_table[i].decode_ptt & ~band_decode_pin_mask(band_decode_ptt_pins))
+                : (band_decode_table[i].decode & ~band_decode_pin_mask(band_decode_pins)))
+            return false;
+    }
+    return true;
+}
+
+constexpr bool band_decode_pin_in(uint8_t pin, const uint8_t *list, uint8_t count)
+{
+    for (uint8_t i = 0; i < count; i++)
+        if (list[i] == pin)
+            return true;
+    return false;
+}
+
+// Each assigned output pin is used once across both output groups and is not claimed by anything else
+constexpr bool band_decode_pins_free(void)
+{
+    for (uint8_t i = 0; i < BAND_DECODE_BITS; i++)
+    {
+        uint8_t d = band_decode_pins[i];
+        uint8_t p = band_decode_ptt_pins[i];
+
+        if (d != GPIO_PIN_NOT_USED)
+        {
+            if (band_decode_pin_in(d, &band_decode_pins[i+1], BAND_DECODE_BITS - i - 1))  return false;
+            if (band_decode_pin_in(d, band_decode_ptt_pins, BAND_DECODE_BITS))            return false;
+            if (band_decode_pin_in(d, band_decode_reserved_pins, sizeof(band_decode_reserved_pins))) return false;
+        }
+        if (p != GPIO_PIN_NOT_USED)
+        {
+            if (band_decode_pin_in(p, &band_decode_ptt_pins[i+1], BAND_DECODE_BITS - i - 1)) return false;
+            if (band_decode_pin_in(p, band_decode_reserved_pins, sizeof(band_decode_reserved_pins))) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(BAND_DECODE_ROWS == BAND122G + 1,   "band_decode_table must have one row per band up to BAND122G");
+static_assert(band_decode_rows_in_order(),        "band_decode_table rows must be in band number order");
+static_assert(BS_122G - BS_160M + 1 == BAND_DECODE_ROWS, "Band buttons BS_160M..BS_122G must line up with band_decode_table rows");
+static_assert(band_decode_codes_unique(false),    "Two enabled bands have the same DECODE_BANDxxx pattern");
+static_assert(band_decode_codes_unique(true),     "Two enabled bands have the same DECODE_BANDxxx_PTT pattern");
+static_assert(band_decode_codes_fit(false),       "An enabled DECODE_BANDxxx pattern uses a bit with no BAND_DECODE_OUTPUT_PIN assigned");
+static_assert(band_decode_codes_fit(true),        "An enabled DECODE_BANDxxx_PTT pattern uses a bit with no BAND_DECODE_PTT_OUTPUT_PIN assigned");
+static_assert(band_decode_pins_free(),            "A band decode output pin is assigned twice or collides with an enabled switch, encoder, PTT or other pin");
+
+#endif // _BAND_TABLE_H_
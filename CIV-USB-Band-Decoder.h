@@ -81,6 +81,8 @@
 // Simple ways to designate functions to run out of fast or slower memory to help save RAM
 #define HOT     FASTRUN     __attribute__((hot))
 #define COLD    FLASHMEM    __attribute__((cold))
+#include "Placement.h"    // HOT or COLD for the profiled functions, generated by PythonApps/placement_gen.py
+#include "Profile.h"
 
 //
 //--------------------------------- RA8875 LCD TOUCH DISPLAY INIT & PINS --------------------------
@@ -321,6 +323,8 @@ const uint16_t myVDARKGREEN = 0x12C3; // very dark green  spectrum function want
 #define I2C_ENC     2
 #define GPIO_SW     3
 #define NONE        0
+#define LO_LOW_SIDE     0   // Xvtr_LO injection
+#define LO_HIGH_SIDE    1
 #ifdef USE_RA8875
 #define STD_BTN_NUM 59      // number of rows in the buttons table
 #else
@@ -460,6 +464,27 @@ struct Band_Memory {
     uint16_t    xvtr_PwrSet;    // last used xvtr power level  
     int16_t     DialCal;        // Calibration offset correction to apply to main frequency (VFOA) - most useful for unlocked LO transverters
     uint16_t    bandDecode;     // Output pattern for band decoder per-band. 
+    uint8_t     step_atten;     // external step attenuator setting in 0.5dB steps (0-63 for a PE4302).  See Attenuator.cpp
+    uint16_t    tx_limit;       // longest continuous TX in seconds before a forced unkey, 0 = no limit.  See TX_Timer.cpp
+    uint8_t     drive_limit;    // highest radio RF power level (0-255) allowed on this band, 255 = no limit.  See Drive_Limit.cpp
+};
+
+// Transverter LO chain per band, same index as bandmem[].  Only used when bandmem[].xvtr_IF is set.  See Xvtr.cpp.
+struct Xvtr_LO {
+    uint64_t    lo_base;        // base oscillator in Hz before multiplication.  0 = derive from band edges (edge_lower - IF band edge_lower)
+    uint8_t     lo_mult;        // LO multiplier chain, 1 = none.  Ex: 4 for a x4 LO on 47/76/122GHz
+    int32_t     lo_err_ppb;     // measured LO error in parts per billion, + = LO is high
+    uint8_t     lo_inject;      // LO_LOW_SIDE (RF = IF + LO) or LO_HIGH_SIDE (RF = LO - IF, sideband inverted)
+    int16_t     rx_offset;      // Hz added to the radio (IF) frequency on receive.  Radio dial error
+    int16_t     tx_offset;      // Hz added to the radio (IF) frequency on transmit
+};
+
+#define XVTR_PROF_FIELDS    6       // settings in a Radio_Profile, see Xvtr_Profile.h
+
+// Radio settings captured when leaving a transverter band and restored when coming back.  See Xvtr_Profile.cpp
+struct Radio_Profile {
+    uint8_t     valid;                      // bit per field, 1 = value[] was read from the radio
+    uint16_t    value[XVTR_PROF_FIELDS];    // as the radio reports it.  Levels 0-255, switches 0/1
 };
 
 struct Standard_Button {
@@ -681,17 +706,17 @@ enum keyPressed_t:uint8_t {
     KEY_LOG_PRESSED
 };
 
-// For CIV commands
+// For CIV commands.  Name tables are plain char arrays in flash, no String objects on the heap.
 
 // translation of the radio's general mode
-const String ModeStr[3] = {
+PROGMEM const char ModeStr[3][11] = {
   "MODE_NDEF",
   "MODE_VOICE",
   "MODE_DATA"
 };
 
 // states of radio's DC-Power (on/Off State)
-const String radioOnOffStr[6] = {
+PROGMEM const char radioOnOffStr[6][13] = {
   "RADIO_OFF",
   "RADIO_ON",
   "RADIO_OFF_TR",     // transit from OFF to ON
@@ -701,7 +726,7 @@ const String radioOnOffStr[6] = {
 };
 
 // clear test translation of the modulation modes
-const String modModeStr[MODES_NUM+1] = {
+PROGMEM const char modModeStr[MODES_NUM+1][7] = {
   "LSB   ", // 00 (00 .. 08 is according to ICOM's documentation) 
   "USB   ", // 01
   "AM    ", // 02
@@ -722,7 +747,7 @@ const String modModeStr[MODES_NUM+1] = {
 };
 
 // clear text translation of the Filter setting
-const String FilStr[4] = {
+PROGMEM const char FilStr[4][5] = {
   "NDEF",
   "FIL1",   // 1 (1 .. 3 is according to ICOM's documentation)
   "FIL2",
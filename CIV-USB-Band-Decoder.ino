@@ -57,6 +57,27 @@
 #include "RadioConfig.h"        // Our main configuration file
 #include "CIV-USB-Band-Decoder.h"
 #include "CIV.h"
+#include "Hydrate.h"
+#include "Band_Table.h"
+#include "Xvtr.h"
+#include "Xvtr_Profile.h"
+#include "Attenuator.h"
+#include "Watchdog.h"
+#include "TX_Timer.h"
+#include "Drive_Limit.h"
+#include "Interlock.h"
+#include "Band_Guard.h"
+#include "Event_Log.h"
+#include "Crash.h"
+#include "Mem_Stats.h"
+#include "Freq_Codec.h"
+#include "Write_Combine.h"
+#include "Mode_Map.h"
+#include "Radio_Model.h"
+#include "Link.h"
+#include "Xcv_Track.h"
+#include "CIV_Fault.h"
+#include "Radio_State.h"
 #include "SDR_Data.h"
 #include "SDR_I2C_Encoder.h"    // See RadioConfig.h for more config including assigning an INT pin.                                          
                                 // Hardware verson 2.1, Arduino library version 1.40.      
@@ -184,12 +205,10 @@ Metro MF_Timeout           = Metro(1800);   // MultiFunction Knob and Switch
 Metro touchBeep_timer      = Metro(80);     // Feedback beep for button touches
 Metro gpio_ENC2_Read_timer = Metro(700);    // time allowed to accumulate counts for slow moving detented encoders
 Metro gpio_ENC3_Read_timer = Metro(700);    // time allowed to accumulate counts for slow moving detented encoders
-Metro TX_Timeout           = Metro(180000); // 180000 is 3 minutes for RunawayTX timeout
 Metro CAT_Serial_Check     = Metro(20);     // Throttle the servicing for CAT comms
 Metro CAT_Poll             = Metro(5000);  // Throttle the servicing for CAT comms
 Metro CAT_Log_Clear        = Metro(3000);   // Clear the CIV log buffer
 Metro CAT_Freq_Check       = Metro(60);   // Clear the CIV log buffer
-Metro CAT_RX_TX_Check      = Metro(500);   // Clear the CIV log buffer
 
 int64_t     xvtr_offset     = 0;
 int16_t     rit_offset      = 0;    // global RIT offset value in Hz. -9999Hz to +9999H
@@ -237,7 +256,10 @@ unsigned long time_last_baseloop;     // will be updated at the end of every bas
 
 void setup()
 {
+    Mem_Init();        // paint the stack before setup() uses much of it
     DSERIALBEGIN(115200);
+    Event_Log_Init();  // before anything can log, keeps the events from before a reset
+    Crash_Init();      // faults from here on are recorded and reported on the next boot
     delay(1000);
     if (CrashReport) Serial.print(CrashReport);
 
@@ -279,6 +301,8 @@ void setup()
 
     // Set up band decoder output pins using pins configured in RadioConfig.h
     Decoder_GPIO_Pin_Setup();
+    Interlock_Init();  // fault inputs guard the PTT outputs from here on
+    Atten_Init(&PE4302_Atten);  // does nothing unless PE4302 is defined in RadioConfig.h
 
     // Serach for a default_MF_client tag and save it in a global var
     for (default_MF_slot = 0; default_MF_slot < NUM_AUX_ENCODERS; default_MF_slot++)
@@ -389,13 +413,14 @@ void setup()
     #endif
 
     while (!Serial && (millis() < 5000)) ; // wait for Arduino Serial Monitor
+    Watchdog_Report();  // say so if the last reset was the watchdog
     PC_Debug_port.println("\n\nUSB Host Testing - Serial V0.2");
     tft.setCursor(70, 300);
     tft.setFont(Arial_20_Bold);
     tft.setTextColor(WHITE);
     tft.print("Initializing USB Host port to Radio - Cable Connected?");
     
-    civ_905_setup();   
+    civ_radio_setup();   
 
     send_CIV_WakeUp_to_Radio();  // wake up the radio if it is sleeping
     delay(100);
@@ -415,13 +440,14 @@ void setup()
     
     // open or create our config file.  Filenames follow DOS 8.3 format rules
     if (sdSetup) Open_SD_cfgfile();
+    Crash_Report();  // if the last reset was a fault, show it on the splash screen and save it to the SD card
     
     // test our file
     // make a string for assembling the data to log:
 
     // Normally just read config from SD card assuming it is not corrupt.
     // There maybe times yu want to force a copy from default memory (SDR_DATA.h defaults) at bootup overriding what is on the SD card
-    // This would occur when you change the structures in SDR_DAta.h
+    // A file written with different structures in SDR_DAta.h is detected by its header and skipped, the defaults stay.
     // You can force a clean default values write here.
     
     if (RESET_MEMORY == 1)   // set this in RadioConfig.h.  1 will write the compiled defaults database values into memory losing all saved data.
@@ -432,22 +458,15 @@ void setup()
     if (sdSetup) read_db_tables();              // Read in stored values to memory
     //write_radiocfg_h();         // write out the #define to a file on the SD card.
                                     // This could be used by the PC during compile to override the RadioConfig.h
+    Xvtr_Check();                   // band edges may have come from SD, make sure each transverter band converts cleanly
+    Mode_Map_Init();                // modeList may have come from SD too, build the radio mode lookup from it
 
     // -------- Setup our radio settings and UI layout --------------------------------
     PAN(0);
 
-    get_MY_POSITION_from_Radio();
-    delay(100);
-
-    // Consider overriding our defaults with the radio's Bandstack values for each band (3 values per band)
+    // Position, time and the radio's Bandstack values for each band (3 values per band) are fetched in the background
+    // by Hydrate_Service() after the display is up.  Until then the SD snapshot values are used.
     // transverter bands will use the bandmem table defaults until the radio sends something in use.
-    for (int i = 1; i <= 6; i++)
-    {
-        for (int j = 1; j <= 3; j++)
-        {
-            //read_BSTACK_from_Radio(i, j);
-        }
-    }
 
     #ifdef USE_RA8875
         tft.clearScreen();
@@ -472,8 +491,6 @@ void setup()
     
     //get_Freq_from_Radio();   // get freq from radio, comment this out if you want the remote database stored to rule
     
-    delay(400);
-    
     DPRINT("Setup: VFOA = "); DPRINTLN(VFOA);
 
     #if defined USE_CAT_SER
@@ -486,6 +503,7 @@ void setup()
                     // Call changeBands() here after volume to get proper startup volume
     
     DPRINTF("\nInitial Dial Frequency is "); DPRINT(formatVFO(VFOA)); DPRINTLNF("MHz");
+    DPRINTF("Setup: First band decode output at "); DPRINT(millis()); DPRINTLNF("ms after boot");
 
     InternalTemperature.begin(TEMPERATURE_NO_ADC_SETTING_CHANGES);
  
@@ -493,6 +511,16 @@ void setup()
     update_icon_outline(); // update any icons related to active encoders functions  This also calls displayRefresh.
     displayRefresh();
 
+    RS_Subscribe(RS_MASK(RS_PREAMP) | RS_MASK(RS_ATTN) | RS_MASK(RS_AGC) | RS_MASK(RS_SPLIT) | RS_MASK(RS_TX), Radio_State_Changed);
+    TX_Timer_Init();
+    Link_Init();
+    Radio_Model_Detect();  // ask the radio what it is, then refresh band stack and radio state for it in the background
+    Mem_Report();
+    #ifdef PROFILE
+        Prof_Init();    // count from here, boot time would swamp the loop functions
+    #endif
+    Watchdog_Init();  // last, setup() has long blocking steps.  loop() must check in from here on
+
      PC_Debug_port.println("End of Setup");
 }
 
@@ -539,6 +567,7 @@ void loop()
 
     pass_CAT_msg_to_PC();   // civ.readmsg() always does this.
     pass_CAT_msgs_to_RADIO();  // if a PC is connected pass on CAT commands to the RADIO transparently.   At this point no collision handling performed.
+    Watchdog_Checkin(WD_STAGE_CAT);
 
     #ifdef DEBUG
         time_sp = millis();
@@ -580,14 +609,45 @@ void loop()
         newFreq = 0;
     }
 
-    if (CAT_RX_TX_Check.check() == 1) 
-    {
-        //get_RXTX_from_Radio(); // poll the TX/RX state of the radio
-        delay(10);
-    }
-    
+    TX_Timer_Service();  // polls the TX/RX state of the radio and PTT_INPUT, forces RX when the band TX limit runs out
+    Drive_Limit_Service();  // RF power read back and watch against the band drive limit
+    Interlock_Service();    // fault inputs.  RX is already forced by the sampling interrupt, this does the radio and screen
+    Band_Guard_Service();   // band change asked for during TX, applied after RX and the relay settle time
+    Link_Service();         // CI-V link watch, outputs to safe on a loss, re-sync on recovery
+    Event_Log_Service();    // events to the SD card
+    Mem_Service();          // stack and heap high-water marks
+    WC_Service();           // combined CI-V setting writes whose spacing is up
+    Xcv_Service();          // frequency and mode reads when the radio's transceive reports stop
+    CIV_Fault_Service();    // CI-V fault soak rounds, idle unless started from the Debug port
+
+    #ifdef DEBUG    // the Debug port is only ours when debug output is on
+        if (PC_Debug_port.available())
+        {
+            switch (PC_Debug_port.read())
+            {
+                case EVENT_LOG_DUMP_KEY: Event_Log_Dump(); break;
+                case MEM_REPORT_KEY:     Mem_Report();     break;
+                case FREQ_CHECK_KEY:     Freq_Codec_Check(); break;
+                case RADIO_MODEL_KEY:    Radio_Model_Next(); break;
+                case LINK_DROP_KEY:      Link_Drop(!Link_Dropped()); break;
+                case XCV_DROP_KEY:       Xcv_Drop(!Xcv_Dropped()); break;
+                case CIV_FAULT_KEY:      CIV_Fault_Soak(!CIV_Fault_Soaking()); break;
+                case XVTR_PROFILE_KEY:   Xvtr_Profile_Show(curr_band); break;
+                case XVTR_CLEAR_KEY:     Xvtr_Profile_Clear(curr_band); Xvtr_Profile_Show(curr_band); break;
+                #ifdef PROFILE
+                case PROFILE_REPORT_KEY: Prof_Report();    break;
+                #endif
+            }
+        }
+    #endif
+
     //Check_radio();
 
+    Radio_Model_Service();  // radio ID query at connect, one address per RADIO_DETECT_MS
+    Hydrate_Service();  // background band stack refresh after boot, one request per pass
+    RS_Service();       // radio state change notifications to the screen, band memory and TX timer
+    Watchdog_Checkin(WD_STAGE_RADIO);
+
     if (CAT_Poll.check() == 1) show_CIV_log();
 
     #if defined I2C_ENCODERS || defined MECH_ENCODERS
@@ -595,6 +655,7 @@ void loop()
     #endif
 
     Check_GPIO_Switches();
+    Watchdog_Checkin(WD_STAGE_UI);
 
     if (MF_Timeout.check() == 1)
     {
@@ -613,8 +674,11 @@ void loop()
     if (popup_timer.check() == 1 && popup) // stop spectrum updates, clear the screen and post up a keyboard or something
     {
         // timeout the active window
-        pop_win_down(BAND_MENU);
-        Band(255);
+        if (!Event_Log_Hide())
+        {
+            pop_win_down(BAND_MENU);
+            Band(255);
+        }
     }
 
     // The timer and flag are set by the rogerBeep() function
@@ -663,24 +727,10 @@ void loop()
             displayTime();
         }
     }
-}
-
-//---------------------------------------------------------------------------------------------------------
 
-unsigned int hexToDec(String hexString) {
-    hexString.reserve(2);
-    unsigned int decValue = 0;
-    unsigned int nextInt;
-    for (unsigned int i = 0; i < hexString.length(); i++) {
-        nextInt = int(hexString.charAt(i));
-        if (nextInt >= 48 && nextInt <= 57) nextInt = map(nextInt, 48, 57, 0, 9);
-        if (nextInt >= 65 && nextInt <= 70) nextInt = map(nextInt, 65, 70, 10, 15);
-        if (nextInt >= 97 && nextInt <= 102) nextInt = map(nextInt, 97, 102, 10, 15);
-        nextInt = constrain((signed)nextInt, 0, 15);
-        decValue = (decValue * 16) + nextInt;
-    }
-    return decValue;
+    Watchdog_Service();   // feeds the hardware watchdog only if every stage checked in this pass
 }
+
 //---------------------------------------------------------------------------------------------------------
 
 bool CompareStrings(const char *sz1, const char *sz2) {
@@ -1129,30 +1179,8 @@ void init_band_map(void)
 {
     // Initialize Band Map.  255 means band is inactive.
     // Overwrites Panel_Pos default values in std_btn table band rows.
-    (ENABLE_160M_BAND == 1)? enable_band(BS_160M, 1): enable_band(BS_160M, 0);
-    (ENABLE_80M_BAND  == 1)? enable_band(BS_80M,  1): enable_band(BS_80M,  0);
-    (ENABLE_60M_BAND  == 1)? enable_band(BS_60M,  1): enable_band(BS_60M,  0);
-    (ENABLE_40M_BAND  == 1)? enable_band(BS_40M,  1): enable_band(BS_40M,  0);
-    (ENABLE_30M_BAND  == 1)? enable_band(BS_30M,  1): enable_band(BS_30M,  0);
-    (ENABLE_20M_BAND  == 1)? enable_band(BS_20M,  1): enable_band(BS_20M,  0);
-    (ENABLE_17M_BAND  == 1)? enable_band(BS_17M,  1): enable_band(BS_17M,  0);
-    (ENABLE_15M_BAND  == 1)? enable_band(BS_15M,  1): enable_band(BS_15M,  0);
-    (ENABLE_12M_BAND  == 1)? enable_band(BS_12M,  1): enable_band(BS_12M,  0);
-    (ENABLE_10M_BAND  == 1)? enable_band(BS_10M,  1): enable_band(BS_10M,  0);
-    (ENABLE_6M_BAND   == 1)? enable_band(BS_6M,   1): enable_band(BS_6M,   0);
-    (ENABLE_144_BAND  == 1)? enable_band(BS_144,  1): enable_band(BS_144,  0);
-    (ENABLE_222_BAND  == 1)? enable_band(BS_222,  1): enable_band(BS_222,  0);
-    (ENABLE_432_BAND  == 1)? enable_band(BS_432,  1): enable_band(BS_432,  0);
-    (ENABLE_902_BAND  == 1)? enable_band(BS_902,  1): enable_band(BS_902,  0);
-    (ENABLE_1296_BAND == 1)? enable_band(BS_1296, 1): enable_band(BS_1296, 0);
-    (ENABLE_2400_BAND == 1)? enable_band(BS_2400, 1): enable_band(BS_2400, 0);
-    (ENABLE_3400_BAND == 1)? enable_band(BS_3400, 1): enable_band(BS_3400, 0);
-    (ENABLE_5760_BAND == 1)? enable_band(BS_5760, 1): enable_band(BS_5760, 0);
-    (ENABLE_10G_BAND  == 1)? enable_band(BS_10G,  1): enable_band(BS_10G,  0);
-    (ENABLE_24G_BAND  == 1)? enable_band(BS_24G,  1): enable_band(BS_24G,  0);
-    (ENABLE_47G_BAND  == 1)? enable_band(BS_47G,  1): enable_band(BS_47G,  0);
-    (ENABLE_76G_BAND  == 1)? enable_band(BS_76G,  1): enable_band(BS_76G,  0);
-    (ENABLE_122G_BAND == 1)? enable_band(BS_122G, 1): enable_band(BS_122G, 0);
+    for (uint8_t i = 0; i < BAND_DECODE_ROWS; i++)
+        enable_band(BS_160M + i, (band_decode_table[i].enabled == 1) ? 1 : 0);
 }
 
 void enable_band(uint8_t _band, uint8_t _enable)
@@ -1410,14 +1438,14 @@ uint8_t Check_radio(void)
                 //  correct for transverter band offset
                 if (_xvtr_IF)
                 {    
-                    VFO_temp = radio_VFO + xvtr_offset;   // might have to consider adding in XIT or RIT like done in Tuner.cpp?
+                    VFO_temp = Xvtr_IF_to_RF(curr_band, radio_VFO, user_settings[user_Profile].xmit);   // might have to consider adding in XIT or RIT like done in Tuner.cpp?
 
                     DPRINT("Check_radio: Incoming VFO change:    XVTR Band      - VFO_temp: "); DPRINT(VFO_temp); DPRINT("  Radio VFO: "); DPRINT(radio_VFO); DPRINTF("  Band: "); DPRINT(bandmem[curr_band].band_name); DPRINT("  IF BAND: "); DPRINTLN(bandmem[_xvtr_IF].band_name);           
 
                     if ( radio_VFO >= bandmem[_xvtr_IF].edge_upper)
-                        VFO_temp = bandmem[_xvtr_IF].edge_upper + xvtr_offset;
+                        VFO_temp = Xvtr_IF_to_RF(curr_band, bandmem[_xvtr_IF].edge_upper, user_settings[user_Profile].xmit);
                     else if (radio_VFO < bandmem[_xvtr_IF].edge_lower)
-                        VFO_temp = bandmem[_xvtr_IF].edge_lower + xvtr_offset;  // set possible VFOA and then verify it is still in the band
+                        VFO_temp = Xvtr_IF_to_RF(curr_band, bandmem[_xvtr_IF].edge_lower, user_settings[user_Profile].xmit);  // set possible VFOA and then verify it is still in the band
                         
                     DPRINTF("  lower IF: "); DPRINT(bandmem[_xvtr_IF].edge_lower); DPRINTF("  Upper IF: ");DPRINTLN(bandmem[_xvtr_IF].edge_upper);
                 
@@ -1464,8 +1492,7 @@ uint8_t Check_radio(void)
                 break;
     
         case 5: // RX TX status has changed, display the state
-                DPRINTF("Check_radio: RX TX = "); DPRINTLN(user_settings[user_Profile].xmit);
-                displayXMIT();
+                DPRINTF("Check_radio: RX TX = "); DPRINTLN(RS_Get(RS_TX));   // screen and TX timer follow through Radio_State listeners
                 break;
 
         case 6:
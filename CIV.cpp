@@ -8,6 +8,19 @@
 #include "CIV-USB-Band-Decoder.h"
 #include "RadioConfig.h"
 #include "CIV.h"
+#include "CIV_Stats.h"
+#include "Freq_Codec.h"
+#include "Write_Combine.h"
+#include "Mode_Map.h"
+#include "Hydrate.h"
+#include "Xvtr.h"
+#include "Radio_State.h"
+#include "Radio_Model.h"
+#include "Link.h"
+#include "Xcv_Track.h"
+#include "CIV_Fault.h"
+#include "Band_Guard.h"
+#include "No_Heap.h"
 
 extern Metro CAT_Poll;        // Throttle the servicing for CAT comms
 extern Metro CAT_Log_Clear;   // Clear the CIV log buffer
@@ -29,11 +42,25 @@ extern struct Band_Memory bandmem[];
 extern struct Modes_List modeList[];
 extern struct Filter_Settings filter[];
 extern struct User_Settings user_settings[];
-extern struct AGC agc_set[];
-extern unsigned int hexToDec(String hexString);
 
 uint64_t freq = 0;
 
+// In flash, no String objects on the heap
+PROGMEM static const char retValStr[CIV_RETVALS][17] = {
+  "CIV_OK",
+  "CIV_OK_DAV",
+  "CIV_NOK",
+  "CIV_HW_FAULT",
+  "CIV_BUS_BUSY",
+  "CIV_BUS_CONFLICT",
+  "CIV_NO_MSG"
+};
+
+const char * CIV_RetVal_Str(uint8_t retVal)
+{
+  return retVal < CIV_RETVALS ? retValStr[retVal] : "?";
+}
+
 struct cmdList cmd_List[End_of_Cmd_List] = {
     {CIV_C_F_SEND,          {1,0x00}},                      // send operating frequency to all
     {CIV_C_F1_SEND,         {1,0x05}},                      // send operating frequency to one
@@ -118,11 +145,18 @@ CIV civ;  // create the CIV-Interface object
 
 CIVresult_t CIVresultL;
 
-void civ_905_setup(void) 
+void civ_radio_setup(void) 
 {
   civ.setupp(true, false, "");     // initialize the civ object/module
                                    // and the ICradio objects
   civ.registerAddr(CIV_ADDR);  // tell civ, that this is a valid address to be used
+  civ.registerAddr(CIV_ADDR_705);   // and every model's factory address, Radio_Model_Detect() asks each for its ID
+  civ.registerAddr(CIV_ADDR_905);
+  civ.registerAddr(CIV_ADDR_9700);
+  civ.registerAddr(CIV_ADDR_7300);
+  civ.registerAddr(CIV_ADDR_7100);
+  Radio_Model_Init();  // CIV_ADDR's model until the radio says otherwise
+  CIV_Stats_Init();  // clear the receive counters
 }
 
 //***************************************************************************
@@ -137,19 +171,26 @@ void civ_905_setup(void)
 //
 //***************************************************************************
 //
-uint8_t check_CIV(uint32_t time_current_baseloop) 
+PLACE(check_CIV) uint8_t check_CIV(uint32_t time_current_baseloop) 
 {
+  	PROF(check_CIV);
   	uint8_t msg_type = 0;
 	static uint8_t cmd_num = 0;
 	uint8_t match = 0;
 
   	msg_type = 0;
-  	CIVresultL = civ.readMsg(CIV_ADDR);
+  	CIVresultL = civ.readMsg(radio_addr);
+	CIV_Fault_Filter(&CIVresultL);  // bench soak only, passes everything through otherwise
+	if (Link_Dropped())  // test hook, as if the cable were out
+		return 0;
+	CIV_Stats_Count(CIVresultL.retVal);
 
   	freqReceived = false;
 	
   	if (CIVresultL.retVal <= CIV_NOK) // valid answer received !
 	{  
+		Link_Frame();  // the radio is there
+		Radio_Model_Frame();
 
 		if (CIVresultL.retVal == CIV_OK_DAV) 
 		{  
@@ -180,6 +221,7 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 			if (cmd_num >= End_of_Cmd_List-1)
 			{
 				cmd_num--;
+				CIV_Stats_Count_Unknown();
 				PC_Debug_port.printf("Loop Completed, NO match found -- cmd_num=%d from radio length=%d and cmd=%X, on remote length=%d and cmd=%X\n",cmd_num, CIVresultL.cmd[0], CIVresultL.cmd[1], cmd_List[cmd_num].cmdData[0], cmd_List[cmd_num].cmdData[1]);
 				//DPRINTF("check_CIV: No match found: for "); DPRINTLN(cmd_num);
 				return 0;
@@ -188,6 +230,8 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 			{
 				//DPRINTF("check_CIV: Match Cmd list index: "); DPRINT(cmd_num);  DPRINTF("  CMD: "); DPRINTLN(CIVresultL.cmd[1],HEX);   
 			}		
+			if (Xcv_Dropped() && (cmd_num == CIV_C_F_SEND || cmd_num == CIV_C_F1_SEND || cmd_num == CIV_C_MOD_SEND || cmd_num == CIV_C_MOD1_SEND))  // test hook, as if Transceive were off
+				return 0;
 			// Check for Frequency message type
 			// NOTE:  when ther radio side changes bands the first message is a mode change followed by the frequency. 
 			// An attempt to get the 0x26 extended mode while the frequency is being sent results in a reliabl BUS conflict and mode and freq both fail.
@@ -200,6 +244,8 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 				{  // command CIV_C_F_SEND received
 					//DPRINTF("check_CIV: CI-V Returned Frequency: "); DPRINTLN(CIVresultL.value);
 					radio_VFO = (uint64_t)CIVresultL.value;
+					Xcv_Freq(radio_VFO, cmd_num != CIV_C_F_READ);  // before RS_Radio(), it compares against the old value
+					RS_Radio(RS_FREQ, radio_VFO);
 					msg_type = 1;
 					freqReceived = true;
 					break;
@@ -209,20 +255,22 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 				case CIV_C_MOD_SEND:
 				{  
 					// command CIV_C_MODE_READ received
-					radio_mode = CIVresultL.value/100;
-					DPRINTF("\ncheck_CIV: Mode in BCD: "); DPRINTLN(radio_mode);
+					Xcv_Mode(cmd_num == CIV_C_MOD_SEND);
+					uint8_t mode = CIVresultL.value/100;
+					DPRINTF("\ncheck_CIV: Mode in BCD: "); DPRINTLN(mode);
 					
-					// look up the bcd value in our modelist table to see what radio mode it is 
-					for (uint8_t i = 0; i< MODES_NUM; i++)
+					// look up the bcd value in our modelist table to see what radio mode it is.  This reply has no data flag.
+					mode = Mode_Map_Index(Xvtr_Radio_Mode(curr_band, bcdByteEncode(mode)), 0);
+					if (mode == MODE_NONE)
 					{
-						if (modeList[i].mode_num == hexToDec(radio_mode))  // match bcd value to table mode_num value to get out mode index that we store
-						{	
-							radio_mode = i;  // now know our decimal index
-							break;  
-						}
-					}// radio_mode now converted to a table index
+						DPRINTLNF("check_CIV: Mode not in modeList, skipping");
+						break;
+					}	// the last good radio_mode stays until a mode maps
 					
+					radio_mode   = mode;  // now a table index
 					radio_filter = CIVresultL.value - ((CIVresultL.value/100)*100);
+					RS_Radio(RS_MODE, radio_mode);
+					RS_Radio(RS_FILTER, radio_filter);
 					
 					DPRINTF("check_CIV: CI-V Returned Mode: "); DPRINT(modeList[radio_mode].mode_label);  DPRINTF("  Radio Mode = "); DPRINT(radio_mode); DPRINTF("  Filter = "); DPRINTLN(filter[radio_filter].Filter_name);    
 					
@@ -246,57 +294,44 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 
 					DPRINTF("check_CIV: CI-V Returned Band Stack - Band: "); DPRINT(bstack_band); DPRINTF("  Register: "); DPRINT(bstack_reg);
 						
-					uint8_t F_len;
-
-					if (CIV_ADDR == CIV_ADDR_905) 
-						F_len = 6;	// 6 bytes for IC905
-					else
-						F_len = 5;	// 6 bytes for IC705 and other models < 10Ghz
+					uint8_t F_len = Radio_Model_Get()->freq_bytes;  // 6 bytes for IC905, 5 for models < 10GHz
 					
-					uint8_t idx = 0;
 					uint8_t DstartIdx = 3;  // start of freq for 6 bytes for IC905, 5 for other models
 					uint8_t DstopIdx = DstartIdx + F_len;  // start of mode, filter data on/off will be 1-3 bytes after
-					uint8_t rxBuffer[F_len];  // hold 6 bytes of frequency
-					uint64_t mul = 1;
-					uint64_t bstack_freq = 0;
 					uint8_t band = 0;  // temp storage for radio bstack band code to remote bandmem table band index
 
-					for (idx = DstartIdx; idx < DstopIdx; idx++)           // pull out frequency from datafield result
-						rxBuffer[idx-DstartIdx] = CIVresultL.datafield[idx];
-
 					// 6 byte data -> first byte is of lowest order - for 905 10G and up bands
-					for (idx = 0; idx < F_len; idx++) {
-						bstack_freq += (rxBuffer[idx] & 0x0f) * mul; mul *= 10;
-						bstack_freq += (rxBuffer[idx] >> 4) * mul; mul *= 10;
+					if (!CIV_BCD_Valid(&CIVresultL.datafield[DstartIdx], F_len))
+					{
+						DPRINTLNF("  Bad BCD in frequency, skipping");
+						return 0;
 					}
+					uint64_t bstack_freq = Freq_From_BCD(&CIVresultL.datafield[DstartIdx], F_len);
 					DPRINTF("  Frequency: "); DPRINT(bstack_freq);
 					
-					radio_mode = CIVresultL.datafield[DstopIdx];  // modulation mode in BCD
-					radio_filter = CIVresultL.datafield[DstopIdx+1];  // filter 
-					radio_data = CIVresultL.datafield[DstopIdx+2];  // data mode on or off
-					DPRINTF("  Mode: "); DPRINT(radio_mode, HEX); DPRINT("  Filter: ");DPRINT(radio_filter, HEX);  DPRINT("  Data: ");DPRINT(radio_data, HEX);   
+					uint8_t bstack_mode   = CIVresultL.datafield[DstopIdx];  // modulation mode in BCD
+					uint8_t bstack_filter = CIVresultL.datafield[DstopIdx+1];  // filter 
+					uint8_t bstack_data   = CIVresultL.datafield[DstopIdx+2];  // data mode on or off
+					DPRINTF("  Mode: "); DPRINT(bstack_mode, HEX); DPRINT("  Filter: ");DPRINT(bstack_filter, HEX);  DPRINT("  Data: ");DPRINT(bstack_data, HEX);   
 								
 					// convert to our own mode extended mode list to show -D (or not)
-					for (uint8_t i = 0; i< MODES_NUM; i++)
+					bstack_mode = Mode_Map_Index(bstack_mode, bstack_data);
+					if (bstack_mode == MODE_NONE)
 					{
-						if (modeList[i].mode_num == radio_mode && modeList[i].data == radio_data)
-						{
-							radio_mode = i;   
-							break;
-						}
+						DPRINTLNF("  Mode not in modeList, skipping");
+						return 0;
 					}
+					radio_mode   = bstack_mode;
+					radio_filter = bstack_filter;
+					radio_data   = bstack_data;
 					DPRINTF("  Mode Index: "); DPRINT(radio_mode); DPRINTF("  Mode label: "); DPRINTLN(modeList[radio_mode].mode_label); 
 					
 					// convert radio bstack band code to remote bandmem table band index
-					switch (bstack_band)
+					band = Radio_Model_BStack_Band(bstack_band);
+					if (band >= BANDS)
 					{
-						case 1: band = BAND144; break;
-						case 2: band = BAND432; break;
-						case 3: band = BAND1296; break;
-						case 4: band = BAND2400; break;
-						case 5: band = BAND5760; break;
-						case 6: band = BAND10G; break;
-						default: band = BAND144; break;
+						DPRINTLNF("  Band code not known for this radio, skipping");
+						return 0;
 					}
 // ToDo: convert the radio mode to our extended most list which is a combo of mode and data
 // This lookup is probably done elsewhere so put it here too.
@@ -311,16 +346,17 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 						case 2: bandmem[band].vfo_A_last_1 	= bstack_freq; 
 								bandmem[band].mode_A_1 		= radio_mode;
 								bandmem[band].filter_A_1 	= radio_filter;
-								modeList[bandmem[band].mode_A].Width = radio_filter;
-								bandmem[band].data_A_2 		= radio_data;
+								modeList[bandmem[band].mode_A_1].Width = radio_filter;
+								bandmem[band].data_A_1 		= radio_data;
 								break;
 						case 3: bandmem[band].vfo_A_last_2 	= bstack_freq; 
 								bandmem[band].mode_A_2 		= radio_mode;
 								bandmem[band].filter_A_2	= radio_filter; 
-								modeList[bandmem[band].mode_A].Width = radio_filter;
+								modeList[bandmem[band].mode_A_2].Width = radio_filter;
 								bandmem[band].data_A_2 		= radio_data;
 								break;
 					}
+					BStack_Confirm(band, bstack_reg);  // mark the entry fresh and confirmed by the radio
 					msg_type = 3;
 					freqReceived = false;
 					break;
@@ -332,22 +368,26 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 				//case CIV_C_F26_SEND:
 				{
 					// [0]=x is length, [1]== 0 is selected VFO
-					radio_mode   = CIVresultL.datafield[2];  // mode is in HEX!
-					radio_data   = bandmem[curr_band].data_A   = CIVresultL.datafield[3];  // data on/off
-					radio_filter = bandmem[curr_band].filter_A = CIVresultL.datafield[4];  // filter setting
-					modeList[bandmem[curr_band].mode_A].Width = radio_filter;
-
-  					// convert to our own mode list to show -D (or not)
-					for (uint8_t i = 0; i< MODES_NUM; i++)
+					Xcv_Mode(false);
+					uint8_t mode   = Xvtr_Radio_Mode(curr_band, CIVresultL.datafield[2]);  // mode is in HEX!  Sideband flips on a high side LO transverter
+					uint8_t data   = CIVresultL.datafield[3];  // data on/off
+					uint8_t filt   = CIVresultL.datafield[4];  // filter setting
+
+  					// convert to our own mode list to show -D (or not).  Nothing is stored unless it maps.
+					mode = Mode_Map_Index(mode, data);
+					if (mode == MODE_NONE)
 					{
-						if (modeList[i].mode_num == radio_mode && modeList[i].data == radio_data)
-						{
-							radio_mode = bandmem[curr_band].mode_A = i;  // now stored as our index to the combo in modelist table
-							break;
-						}
+						DPRINTLNF("check_CIV: Extended mode not in modeList, skipping");
+						break;
 					}
+					radio_mode   = bandmem[curr_band].mode_A   = mode;  // now stored as our index to the combo in modelist table
+					radio_data   = bandmem[curr_band].data_A   = data;
+					radio_filter = bandmem[curr_band].filter_A = filt;
 					
 					modeList[radio_mode].Width = radio_filter;  // store filter in mode table using the extended mode value (-D or no -D)
+					RS_Radio(RS_MODE, radio_mode);
+					RS_Radio(RS_FILTER, radio_filter);
+					RS_Radio(RS_DATA, radio_data);
 					DPRINTF("check_CIV: CI-V Returned Extended Mode: "); DPRINT(modeList[radio_mode].mode_label); DPRINT("  Filter: "); DPRINT(filter[radio_filter].Filter_name); DPRINT("  Data: "); DPRINTLN(radio_data);  
 					msg_type = 4;
 					freqReceived = false;
@@ -365,13 +405,10 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 					if (TX != TX_last)  // stte has changed
 					{
 						//DPRINTF("check_CIV: CI-V Returned RX-TX status changed: "); DPRINTLN(TX);
-						if (TX == 1) // in TX
-							user_settings[user_Profile].xmit = 1;
-						if (TX == 0) // in RX
-							user_settings[user_Profile].xmit = 0;
 						TX_last = TX; // capure state to detect change
 						msg_type = 5;
 					}  // if no state change then will return default msg_type which is 0 and the main loop wll skip out.
+					RS_Radio(RS_TX, TX ? 1 : 0);  // every reply, a pending RX request gets confirmed even without a change
 					freqReceived = false;
 					break;
 				}  // RX TX  changed	
@@ -383,7 +420,7 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 				{
 					//uint8_t RX = CIVresultL.value;
 
-					//DPRINTF("check_CIV: CI-V Returned MY POSITION and TIME: "); DPRINTLN(retValStr[CIVresultL.value]);
+					//DPRINTF("check_CIV: CI-V Returned MY POSITION and TIME: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.value));
 					//               pos      1             2  3  4  5  6    7  8  9 10 11 12   13 14 15 16   17 18   19 20 21   22 23  24  25  26 27 28 term
 					// FE.FE.E0.AC.  23.00.  datalen byte  47.46.92.50.01.  01.22.01.98.70.00.  00.15.59.00.  01.05.  00.00.07.  20.24. 07. 20. 23.32.45. FD
 					//                                     47.46.925001 lat 122.01.987000 long  155.900m alt  105deg   0.7km/h   2024   07  20  23:32:45 UTC
@@ -405,6 +442,7 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 						DPRINT(_hr);DPRINTF(":");DPRINT(_min);DPRINTF(":");DPRINT(_sec);DPRINTF(" ");DPRINT(_month);DPRINTF(".");DPRINT(_day);DPRINTF(".");DPRINTLN(_yr); 
 					}
 					
+					Hydrate_Confirm(CIV_C_MY_POSIT_READ);
 					msg_type = 6;
 					freqReceived = false;
 					break;
@@ -436,6 +474,7 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 					//get current time and correct or set time zone offset
 					//setTime(_hr,_min,_sec,_day,_month,_yr);
 					
+					Hydrate_Confirm(cmd_num);
 					msg_type = 7;
 					freqReceived = false;
 					break;
@@ -448,21 +487,9 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 					uint8_t _val = CIVresultL.value;
 					
 					DPRINTF("check_CIV: CI-V Returned PreAmp status: "); DPRINTLN(_val);
-
-					if (_val > 0)
-					{
-						// Reading from the radio we just want to update database and screen and not repeat back to radio.
-						bandmem[curr_band].attenuator = ATTN_OFF;   // Only 1 on at a time
-						bandmem[curr_band].preamp = PREAMP_ON;
-					}
-					if (_val == 0)
-					{
-						bandmem[curr_band].preamp = PREAMP_OFF;
-					}
+					RS_Radio(RS_PREAMP, _val);  // band memory and screen follow through Radio_State_Changed()
 					msg_type = 8;
 					freqReceived = false;
-					displayPreamp();
-					displayAttn();
 					break;
 				}  // Preamp changed
 
@@ -470,17 +497,7 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
             uint8_t _val = CIVresultL.value;
 
             //DPRINTF("CIV_Action:  CI-V Returned Preamp status: "); DPRINTLN(_val);
-            if (_val > 0)
-            {
-                //bands[band].atten = ATTN_OFF;
-                bandmem[curr_band].split = 1;              
-            }
-            if (_val == 0)
-            {
-                bandmem[curr_band].split = 0;
-            }
-            //displayAttn();
-            //displayPreamp();
+            RS_Radio(RS_SPLIT, _val ? 1 : 0);
             break;
         }
 
@@ -491,20 +508,9 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 					uint8_t _val = CIVresultL.value;
 
 					DPRINTF("check_CIV: CI-V Returned Attn status: "); DPRINTLN(_val);
-					if (_val > 0)
-					{
-						bandmem[curr_band].preamp 		= PREAMP_OFF;
-						bandmem[curr_band].attenuator  	= ATTN_ON;
-					}
-					if (_val == 0)
-					{
-						bandmem[curr_band].attenuator   = ATTN_OFF;
-					}
-					
+					RS_Radio(RS_ATTN, _val);
 					msg_type = 9;
 					freqReceived = false;
-					displayAttn();
-					displayPreamp();
 					break;
 				}  // Attn changed
 				
@@ -515,13 +521,11 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 				{
 					uint8_t _val = CIVresultL.value;
 
-					if (_val == 1) {bandmem[curr_band].agc_mode = AGC_FAST; AGC(3);} // 0 sets to database state. 2 is toggle state. -1 and 1 are down and up
-					if (_val == 2) {bandmem[curr_band].agc_mode = AGC_MID;  AGC(3);} // 0 sets to database state. 2 is toggle state. -1 and 1 are down and up
-					if (_val == 3) {bandmem[curr_band].agc_mode = AGC_SLOW; AGC(3);} // 0 sets to database state. 2 is toggle state. -1 and 1 are down and up
-					DPRINTF("check_CIV: CI-V Returned AGC state: "); DPRINTLN(agc_set[bandmem[curr_band].agc_mode].agc_name);
+					if (_val >= AGC_FAST && _val <= AGC_SLOW)  // radio values 1-3 are the same as ours
+						RS_Radio(RS_AGC, _val);
+					DPRINTF("check_CIV: CI-V Returned AGC state: "); DPRINTLN(_val);
 					msg_type = 10;
 					freqReceived = false;
-					displayAgc();
 					break;
 				}  // AGC changed
 
@@ -550,6 +554,7 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 					radio_DUP 	  *= 1000;  //convert KHz to Hz
 					//radio_DUP = DUP_MINUS ?  radio_DUP*-1: radio_DUP;
 					DPRINTF("check_CIV: Radio Returned Duplex Offset: "); DPRINT(radio_DUP); DPRINTLNF("Hz");
+					RS_Radio(RS_DUPLEX, radio_DUP);
 
 					msg_type = 11;
 					freqReceived = false;
@@ -570,6 +575,7 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 					radio_RIT  	    += bcdByte(CIVresultL.datafield[1]); 
 					radio_RIT = RIT_MINUS ?  radio_RIT*-1: radio_RIT;
 					DPRINTF("check_CIV: RIT/XIT Offset: "); DPRINT(radio_RIT); DPRINTLNF("Hz");
+					RS_Radio(RS_RIT, radio_RIT);
 
 					msg_type = 12;
 					freqReceived = false;
@@ -581,6 +587,7 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 					
 					radio_RIT_On_Off  	    = bcdByte(CIVresultL.datafield[1]); 
 					DPRINTF("check_CIV: RIT On/Off: "); DPRINTLN(radio_RIT_On_Off);
+					RS_Radio(RS_RIT_ON, radio_RIT_On_Off);
 					msg_type = 13;
 					freqReceived = false;
 					break;
@@ -591,29 +598,39 @@ uint8_t check_CIV(uint32_t time_current_baseloop)
 					
 					radio_XIT_On_Off  	    = bcdByte(CIVresultL.datafield[1]); 
 					DPRINTF("check_CIV: XIT On/Off: "); DPRINTLN(radio_XIT_On_Off);
+					RS_Radio(RS_XIT_ON, radio_XIT_On_Off);
 					msg_type = 14;
 					freqReceived = false;
 					break;
 				}  // XIT On/Off
 
+				case CIV_C_RFPOWER:		// CIV_C_RF_POW is the same command, the search stops here
+				{	// 2 bytes BCD, 0000 to 0255
+					if (CIVresultL.datafield[0] == 2 && CIV_BCD_Valid(&CIVresultL.datafield[1], 2))
+					{
+						uint16_t _pwr = (uint16_t) CIV_BCD_Num_Decode(&CIVresultL.datafield[1], 2);
+						DPRINTF("check_CIV: RF Power: "); DPRINTLN(_pwr);
+						RS_Radio(RS_RF_POWER, _pwr);
+						msg_type = 15;
+					}
+					freqReceived = false;
+					break;
+				}  // RF Power
+
+				case CIV_C_TRX_ID:
+				{	// [1] is the model's ID byte
+					DPRINTF("check_CIV: Radio ID: "); DPRINTLN(CIVresultL.datafield[1], HEX);
+					Radio_Model_Found(CIVresultL.datafield[1]);
+					msg_type = 16;
+					freqReceived = false;
+					break;
+				}  // Radio ID
+
 			}  // end switch
 			return msg_type;
     	}  // Data available
 
-		// ----------------------------------  do a query for frequency, if necessary
-		// poll every 500 * 10ms = 5sec until a valid frequency has been received
-		//if ((freqReceived == false) && (CAT_Freq_Check.check() == 1)) 
-		if (0)  // not sure we need this, possibly corrupting other sequences
-		{
-			delay(20);
-			CIVresultL = civ.writeMsg(CIV_ADDR, cmd_List[CIV_C_F_READ].cmdData, CIV_D_NIX, CIV_wChk);
-			if (CIVresultL.retVal<=CIV_NOK)
-			{
-				DPRINTF("check_CIV: Poll for RADIO Frequency Status: "); DPRINT(CIVresultL.retVal);
-				DPRINTF("  Poll for RADIO Frequency Return Value: "); DPRINTLN((uint8_t)CIVresultL.value);
-				msg_type = 1;
-			}
-		}
+		// Frequency polling, when the radio does not send transceive reports, is in Xcv_Service()
 	}// valid answer received
   	return msg_type;
 }  // if BASELOOP_TICK
@@ -641,6 +658,11 @@ void show_CIV_log(void)
 {
   //if (CAT_Poll.check() == 1)
     civ.logDisplay();  // show messages accumulated until cleared.
+    CIV_Stats_Show_Stats();  // nak, collision, busy and unknown command counters
+    WC_Show_Stats();          // write combining and knob to radio lag
+    Link_Show_Stats();        // keep-alive probes, link losses and outage times
+    Xcv_Show_Stats();         // transceive reports against frequency polling
+    Band_Guard_Show_Stats();  // band changes held for TX and any switched keyed
 
   // can clear the log periodically here based on timer
   //if (CAT_Log_Clear.check() == 1)  // Clear the CIV log buffer, jsu show last 2 seconds
@@ -656,6 +678,26 @@ uint8_t getByteResponse(const uint8_t m_Counter, const uint8_t offset, const uin
     return ret;
 }
 
+// Numeric fields such as levels are BCD most significant byte first.  0x01 0x28 = 128
+HOT uint32_t CIV_BCD_Num_Decode(const uint8_t *p, uint8_t len)
+{
+    uint32_t val = 0;
+
+    for (uint8_t i = 0; i < len; i++)
+        val = val * 100 + ((p[i] >> 4) * 10) + (p[i] & 0x0F);
+    return val;
+}
+
+HOT bool CIV_BCD_Valid(const uint8_t *p, uint8_t len)
+{
+    for (uint8_t i = 0; i < len; i++)
+    {
+        if ((p[i] >> 4) > 9 || (p[i] & 0x0F) > 9)
+            return false;
+    }
+    return true;
+}
+
 
 // below lines are in case you want to stop/start log scrolling
 // use "l",if "#define log_CIV" in file civ.h is active
@@ -19,7 +19,7 @@ uint8_t check_CIV(uint32_t time_current_baseloop);
 uint64_t FrequencyRequest(void);
 void RcvCIVmsg(void);
 void SendCIVmsg(void);
-void civ_905_setup(void);
+void civ_radio_setup(void);
 void pass_CAT_msgs_to_RADIO(void);
 void pass_CAT_msg_to_PC(void);
 void show_CIV_log(void);
@@ -27,19 +27,14 @@ void civ_setup(uint32_t currentTime);
 //radioModMode_t getModMode(void);
 uint8_t getByteResponse(const uint8_t m_Counter, const uint8_t offset, const uint8_t buffer[]);
 uint8_t getRadioMode(void);
+uint32_t CIV_BCD_Num_Decode(const uint8_t *p, uint8_t len);    // MSB first BCD such as levels 0000-0255, frequencies are in Freq_Codec.h
+bool CIV_BCD_Valid(const uint8_t *p, uint8_t len);              // false if any nibble > 9
 
 #ifdef GPS
   void pass_GPS(void);
 #endif
 
-const String retValStr[7] = {
-  "CIV_OK",
-  "CIV_OK_DAV",
-  "CIV_NOK",
-  "CIV_HW_FAULT",
-  "CIV_BUS_BUSY",
-  "CIV_BUS_CONFLICT",
-  "CIV_NO_MSG"
-};
+#define CIV_RETVALS  7     // CIV_OK .. CIV_NO_MSG
+const char * CIV_RetVal_Str(uint8_t retVal);   // name of a CIVresult_t retVal for debug output
 
 #endif //_CIV_H_
\ No newline at end of file
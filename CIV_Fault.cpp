@@ -0,0 +1,317 @@
+//
+//  CIV_Fault.cpp
+//
+//  CIVmasterLib frames the bytes itself, so faults are applied to whole frames as readMsg() hands them over.  A
+//  dropped or split frame looks the same from here, both come out as a missing frame, and a collision is the
+//  CIV_BUS_CONFLICT the library reports for FC.  Nothing is ever sent to the radio from here.
+//  Held frames come back out on a later pass that read nothing, a reordered one after the next frame got through.
+//  Each frame gets at most one fault.  The generator is reseeded CIV_FAULT_SEED + round at the start of each round.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Controls.h"
+#include "Band_Table.h"
+#include "Hydrate.h"
+#include "Radio_State.h"
+#include "Radio_Model.h"
+#include "Link.h"
+#include "Xvtr.h"
+#include "Freq_Codec.h"
+#include "CIV_Fault.h"
+#include "No_Heap.h"
+
+extern struct Band_Memory bandmem[];
+extern uint8_t curr_band;
+
+enum CIV_Fault_Phase {
+    FAULT_IDLE,
+    FAULT_INJECT,           // faults on for CIV_FAULT_RUN_S
+    FAULT_SETTLE            // faults off, re-sync then check
+};
+
+struct Fault_Hold {
+    CIVresult_t r;
+    uint32_t    due;        // millis() it may go out
+    bool        after_next; // reordered, goes out once another frame has
+    bool        used;
+};
+
+static struct Fault_Hold fault_hold[CIV_FAULT_HOLD];
+static struct CIV_Fault_Stats fault_stats;
+static bool     fault_on     = false;
+static uint8_t  fault_phase  = FAULT_IDLE;
+static uint32_t fault_rnd    = 1;
+static uint32_t fault_start  = 0;       // millis() the phase began
+static uint32_t fault_burst  = 0;       // millis() the latency burst ends
+static uint8_t  fault_jam    = 0;       // frames left in the collision run
+
+// xorshift32, same sequence for the same seed
+static uint8_t CIV_Fault_Pct(void)
+{
+    fault_rnd ^= fault_rnd << 13;
+    fault_rnd ^= fault_rnd >> 17;
+    fault_rnd ^= fault_rnd << 5;
+    return fault_rnd % 100;
+}
+
+static bool CIV_Fault_Hold(const CIVresult_t *r, uint32_t due, bool after_next)
+{
+    for (uint8_t i = 0; i < CIV_FAULT_HOLD; i++)
+    {
+        if (fault_hold[i].used)
+            continue;
+        fault_hold[i].r          = *r;
+        fault_hold[i].due        = due;
+        fault_hold[i].after_next = after_next;
+        fault_hold[i].used       = true;
+        return true;
+    }
+    fault_stats.hold_full++;
+    return false;
+}
+
+// One bit in the data, or in the command if there is no data.  A frequency is decoded again from the damaged BCD.
+static void CIV_Fault_Flip(CIVresult_t *r)
+{
+    uint8_t *p = r->datafield[0] ? r->datafield : r->cmd;
+    uint8_t len = p[0];
+
+    if (!len)
+        return;
+    p[1 + CIV_Fault_Pct() % len] ^= 1 << (CIV_Fault_Pct() % 8);
+    if (p == r->datafield && (r->cmd[1] == 0x00 || r->cmd[1] == 0x03) && len <= FREQ_BCD_MAX)
+        r->value = Freq_From_BCD(&r->datafield[1], len);
+    fault_stats.flipped++;
+}
+
+// At most one fault for a frame just read.  Held or lost frames leave r as CIV_NO_MSG.
+static void CIV_Fault_Apply(CIVresult_t *r, uint32_t now)
+{
+    uint8_t pct;
+
+    fault_stats.frames++;
+    if (fault_jam)
+    {
+        fault_jam--;
+        r->retVal = CIV_BUS_CONFLICT;
+        fault_stats.jammed++;
+        return;
+    }
+    if ((int32_t) (fault_burst - now) > 0)
+    {
+        if (CIV_Fault_Hold(r, fault_burst, false))
+        {
+            r->retVal = CIV_NO_MSG;
+            fault_stats.delayed++;
+        }
+        return;
+    }
+
+    pct = CIV_Fault_Pct();
+    if (pct < CIV_FAULT_DROP)
+    {
+        r->retVal = CIV_NO_MSG;
+        fault_stats.dropped++;
+        return;
+    }
+    pct -= CIV_FAULT_DROP;
+    if (pct < CIV_FAULT_FLIP)
+    {
+        if (r->retVal == CIV_OK_DAV)
+            CIV_Fault_Flip(r);
+        return;
+    }
+    pct -= CIV_FAULT_FLIP;
+    if (pct < CIV_FAULT_DUP)
+    {
+        if (CIV_Fault_Hold(r, now, false))
+            fault_stats.duplicated++;
+        return;
+    }
+    pct -= CIV_FAULT_DUP;
+    if (pct < CIV_FAULT_REORDER)
+    {
+        if (CIV_Fault_Hold(r, now, true))
+        {
+            r->retVal = CIV_NO_MSG;
+            fault_stats.reordered++;
+        }
+        return;
+    }
+    pct -= CIV_FAULT_REORDER;
+    if (pct < CIV_FAULT_DELAY)
+    {
+        if (CIV_Fault_Hold(r, now + CIV_FAULT_DELAY_MS, false))
+        {
+            r->retVal = CIV_NO_MSG;
+            fault_stats.delayed++;
+        }
+        return;
+    }
+    pct -= CIV_FAULT_DELAY;
+    if (pct < CIV_FAULT_JAM)
+    {
+        fault_jam = CIV_FAULT_JAM_FRAMES - 1;
+        r->retVal = CIV_BUS_CONFLICT;
+        fault_stats.jammed++;
+        return;
+    }
+    pct -= CIV_FAULT_JAM;
+    if (pct < CIV_FAULT_BURST)
+    {
+        fault_burst = now + CIV_FAULT_BURST_MS;
+        fault_stats.bursts++;
+        if (CIV_Fault_Hold(r, fault_burst, false))
+        {
+            r->retVal = CIV_NO_MSG;
+            fault_stats.delayed++;
+        }
+    }
+}
+
+PLACE(CIV_Fault_Filter) void CIV_Fault_Filter(CIVresult_t *r)
+{
+    PROF(CIV_Fault_Filter);
+    uint32_t now;
+    uint8_t  i, next = CIV_FAULT_HOLD;
+
+    if (!fault_on)
+        return;
+
+    now = millis();
+    if (r->retVal <= CIV_NOK)
+        CIV_Fault_Apply(r, now);
+
+    if (r->retVal <= CIV_NOK)
+    {
+        for (i = 0; i < CIV_FAULT_HOLD; i++)    // a frame is going out, a reordered one follows it
+            if (fault_hold[i].used && fault_hold[i].after_next)
+            {
+                fault_hold[i].after_next = false;
+                fault_hold[i].due        = now;
+            }
+        return;
+    }
+    if (r->retVal == CIV_BUS_CONFLICT)
+        return;
+
+    // nothing this pass, the oldest held frame that is due takes its place
+    for (i = 0; i < CIV_FAULT_HOLD; i++)
+        if (fault_hold[i].used && !fault_hold[i].after_next && (int32_t) (now - fault_hold[i].due) >= 0 &&
+            (next == CIV_FAULT_HOLD || (int32_t) (fault_hold[next].due - fault_hold[i].due) > 0))
+            next = i;
+    if (next < CIV_FAULT_HOLD)
+    {
+        *r = fault_hold[next].r;
+        fault_hold[next].used = false;
+    }
+}
+
+static void CIV_Fault_Inject(bool on)
+{
+    fault_on    = on;
+    fault_jam   = 0;
+    fault_burst = millis();
+    for (uint8_t i = 0; i < CIV_FAULT_HOLD; i++)     // held frames are lost, the same as on the wire
+        fault_hold[i].used = false;
+}
+
+// The radio's frequency is on the band in use (its IF band for a transverter), the band decode pins carry that
+// band's pattern, and no PTT output is keyed while the radio is in RX.
+static bool CIV_Fault_Check(void)
+{
+    uint64_t freq    = (uint64_t) RS_Get(RS_FREQ);
+    uint8_t  rf_band = Xvtr_Active(curr_band) ? bandmem[curr_band].xvtr_IF : curr_band;
+    bool     band_ok, decode_ok, ptt_ok;
+
+    band_ok   = RS_Source(RS_FREQ) == RS_SRC_RADIO && freq >= bandmem[rf_band].edge_lower && freq <= bandmem[rf_band].edge_upper;
+    decode_ok = curr_band >= BAND_DECODE_ROWS || GPIO_Out_Get() == band_decode_table[curr_band].decode;
+    ptt_ok    = RS_Get(RS_TX) || !PTT_Output_Get();
+
+    DPRINTF("CIV_Fault_Check: round "); DPRINT(fault_stats.rounds);
+    DPRINT(band_ok ? "  band OK" : "  band WRONG"); DPRINT(decode_ok ? "  decode OK" : "  decode WRONG");
+    DPRINTLN(ptt_ok ? "  PTT OK" : "  PTT KEYED IN RX");
+    return band_ok && decode_ok && ptt_ok;
+}
+
+static void CIV_Fault_Round(uint32_t now)
+{
+    fault_rnd   = CIV_FAULT_SEED + fault_stats.rounds;
+    if (!fault_rnd)
+        fault_rnd = 1;      // xorshift never leaves 0
+    fault_phase = FAULT_INJECT;
+    fault_start = now;
+    CIV_Fault_Inject(true);
+    DPRINTF("CIV_Fault: round "); DPRINT(fault_stats.rounds); DPRINTF(" seed "); DPRINTLN(fault_rnd);
+}
+
+PLACE(CIV_Fault_Service) void CIV_Fault_Service(void)
+{
+    PROF(CIV_Fault_Service);
+    uint32_t now;
+
+    if (fault_phase == FAULT_IDLE)
+        return;
+
+    now = millis();
+    if (fault_phase == FAULT_INJECT)
+    {
+        if ((now - fault_start) < CIV_FAULT_RUN_S * 1000UL)
+            return;
+        CIV_Fault_Inject(false);
+        fault_phase = FAULT_SETTLE;
+        fault_start = now;
+        if (!Link_Lost() && !Radio_Model_Busy() && !Hydrate_Busy())
+            Hydrate_Start();    // a lost link re-syncs by itself when it comes back
+        return;
+    }
+
+    if ((now - fault_start) < CIV_FAULT_SETTLE_MS || Link_Lost() || Radio_Model_Busy() || Hydrate_Busy())
+        return;
+    if (!CIV_Fault_Check())
+        fault_stats.failed++;
+    fault_stats.rounds++;
+    CIV_Fault_Show_Stats();
+    CIV_Fault_Round(now);
+}
+
+COLD void CIV_Fault_Soak(bool on)
+{
+    if (on)
+    {
+        memset(&fault_stats, 0, sizeof(fault_stats));
+        CIV_Fault_Round(millis());
+        return;
+    }
+    CIV_Fault_Inject(false);
+    fault_phase = FAULT_IDLE;
+    DPRINTLNF("CIV_Fault: soak stopped");
+    CIV_Fault_Show_Stats();
+}
+
+bool CIV_Fault_Soaking(void)
+{
+    return fault_phase != FAULT_IDLE;
+}
+
+const struct CIV_Fault_Stats * CIV_Fault_Get_Stats(void)
+{
+    return &fault_stats;
+}
+
+COLD void CIV_Fault_Show_Stats(void)
+{
+    DPRINTF("CIV_Fault: frames="); DPRINT(fault_stats.frames);
+    DPRINTF(" dropped="); DPRINT(fault_stats.dropped);
+    DPRINTF(" flipped="); DPRINT(fault_stats.flipped);
+    DPRINTF(" dup="); DPRINT(fault_stats.duplicated);
+    DPRINTF(" reordered="); DPRINT(fault_stats.reordered);
+    DPRINTF(" delayed="); DPRINT(fault_stats.delayed);
+    DPRINTF(" jammed="); DPRINT(fault_stats.jammed);
+    DPRINTF(" bursts="); DPRINT(fault_stats.bursts);
+    DPRINTF(" hold_full="); DPRINT(fault_stats.hold_full);
+    DPRINTF(" rounds="); DPRINT(fault_stats.rounds);
+    DPRINTF(" failed="); DPRINTLN(fault_stats.failed);
+}
@@ -0,0 +1,39 @@
+#ifndef _CIV_FAULT_H_
+#define _CIV_FAULT_H_
+//
+//  CIV_Fault.h
+//
+//  Bench fault injection on the CI-V receive path.  Every frame check_CIV() reads can be dropped, bit flipped,
+//  duplicated, swapped with the next one, delayed, turned into a bus collision run or held in a latency burst, at the
+//  CIV_FAULT_xxx rates in RadioConfig.h and from a seeded generator so a round plays out the same way again.
+//  A soak runs rounds of CIV_FAULT_RUN_S with faults on, then re-syncs with faults off and checks that the band,
+//  band decode outputs and PTT agree with the radio.
+//  Bench use only: the firmware acts on what it is fed, so a corrupted frequency can change bands and retune the radio.
+//
+#include <Arduino.h>
+#include <CIVmaster.h>
+
+#define CIV_FAULT_HOLD      8       // frames held back at once for duplicate, reorder, delay and burst.  More go through on time
+
+struct CIV_Fault_Stats {
+    uint32_t frames;            // frames seen while injecting
+    uint32_t dropped;
+    uint32_t flipped;
+    uint32_t duplicated;
+    uint32_t reordered;
+    uint32_t delayed;           // single delays and frames caught in a burst
+    uint32_t jammed;            // frames turned into CIV_BUS_CONFLICT
+    uint32_t bursts;
+    uint32_t hold_full;         // faults skipped, no hold slot free
+    uint32_t rounds;            // soak rounds checked
+    uint32_t failed;            // rounds that did not converge
+};
+
+void CIV_Fault_Filter(CIVresult_t *r);  // check_CIV() right after readMsg().  Changes, holds or releases a frame
+void CIV_Fault_Service(void);           // call every loop pass.  Soak rounds and the convergence check
+void CIV_Fault_Soak(bool on);
+bool CIV_Fault_Soaking(void);
+const struct CIV_Fault_Stats * CIV_Fault_Get_Stats(void);
+void CIV_Fault_Show_Stats(void);
+
+#endif // _CIV_FAULT_H_
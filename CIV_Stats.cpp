@@ -0,0 +1,63 @@
+//
+//  CIV_Stats.cpp
+//
+//  CI-V receive counters.  CIV_NO_MSG is the normal empty read and is not counted.
+//  Nothing here allocates, it is safe to call from the main loop on every pass.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include <CIVmaster.h>
+#include "CIV_Stats.h"
+#include "No_Heap.h"
+
+static struct CIV_Stats civ_stats;
+
+COLD void CIV_Stats_Init(void)
+{
+    memset(&civ_stats, 0, sizeof(civ_stats));
+}
+
+HOT void CIV_Stats_Count(uint8_t retVal)
+{
+    switch (retVal)
+    {
+        case CIV_OK_DAV:        civ_stats.frames++;     break;
+        case CIV_OK:            civ_stats.acks++;       break;
+        case CIV_NOK:           civ_stats.naks++;       break;
+        case CIV_BUS_CONFLICT:  civ_stats.collisions++; break;
+        case CIV_BUS_BUSY:      civ_stats.bus_busy++;   break;
+        case CIV_HW_FAULT:      civ_stats.hw_faults++;  break;
+        default:                                        break;
+    }
+}
+
+// check_CIV() calls this when a frame has no entry in cmd_List[]
+void CIV_Stats_Count_Unknown(void)
+{
+    civ_stats.unknown_cmds++;
+}
+
+const struct CIV_Stats * CIV_Stats_Get_Stats(void)
+{
+    return &civ_stats;
+}
+
+// Print the counters, only when an error count changed since last time to keep the debug port quiet
+COLD void CIV_Stats_Show_Stats(void)
+{
+    static uint32_t last_errors = 0;
+    uint32_t errors = civ_stats.naks + civ_stats.collisions + civ_stats.bus_busy + civ_stats.hw_faults + civ_stats.unknown_cmds;
+
+    if (errors == last_errors)
+        return;
+    last_errors = errors;
+
+    DPRINTF("CIV_Stats: frames="); DPRINT(civ_stats.frames);
+    DPRINTF(" acks="); DPRINT(civ_stats.acks);
+    DPRINTF(" naks="); DPRINT(civ_stats.naks);
+    DPRINTF(" collisions="); DPRINT(civ_stats.collisions);
+    DPRINTF(" busy="); DPRINT(civ_stats.bus_busy);
+    DPRINTF(" hw_faults="); DPRINT(civ_stats.hw_faults);
+    DPRINTF(" unknown="); DPRINTLN(civ_stats.unknown_cmds);
+}
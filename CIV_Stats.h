@@ -0,0 +1,28 @@
+#ifndef _CIV_STATS_H_
+#define _CIV_STATS_H_
+//
+//  CIV_Stats.h
+//
+//  Receive counters for the CI-V link.  CIVmasterLib reads the USB host port and frames the bytes itself, so the
+//  counters cover what readMsg() reports for each result: frames, acks, naks, FC collisions, busy bus and hardware
+//  faults.
+//
+#include <Arduino.h>
+
+struct CIV_Stats {
+    uint32_t frames;                // frames with data
+    uint32_t acks;                  // FB, CIV_OK
+    uint32_t naks;                  // FA, CIV_NOK
+    uint32_t collisions;            // CIV_BUS_CONFLICT, FC jam on the bus
+    uint32_t bus_busy;              // CIV_BUS_BUSY
+    uint32_t hw_faults;             // CIV_HW_FAULT
+    uint32_t unknown_cmds;          // good frames with no match in cmd_List[]
+};
+
+void CIV_Stats_Init(void);                             // clear the counters
+void CIV_Stats_Count(uint8_t retVal);                  // check_CIV() on every readMsg() result
+void CIV_Stats_Count_Unknown(void);
+const struct CIV_Stats * CIV_Stats_Get_Stats(void);
+void CIV_Stats_Show_Stats(void);
+
+#endif // _CIV_STATS_H_
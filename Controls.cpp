@@ -6,6 +6,21 @@
 #include "CIV-USB-Band-Decoder.h"
 #include <CIVmaster.h>
 #include "Controls.h"
+#include "Hydrate.h"
+#include "Band_Table.h"
+#include "Xvtr.h"
+#include "Attenuator.h"
+#include "TX_Timer.h"
+#include "Radio_State.h"
+#include "Radio_Sync.h"
+#include "Xvtr_Profile.h"
+#include "Drive_Limit.h"
+#include "Interlock.h"
+#include "Band_Guard.h"
+#include "Event_Log.h"
+#include "Write_Combine.h"
+#include "Radio_Model.h"
+#include "Link.h"
 
 #ifdef USE_RA8875
     extern RA8875 tft;
@@ -31,7 +46,6 @@ extern struct EncoderList encoder_list[];
 extern struct TuneSteps tstep[];
 extern uint8_t user_Profile;
 extern Metro popup_timer; // used to check for popup screen request
-extern Metro TX_Timeout;  // RunawayTX timeout
 extern uint8_t popup;
 extern volatile int64_t Freq_Peak;
 extern void set_MF_Service(uint8_t client_name);
@@ -73,15 +87,7 @@ extern uint8_t radio_mode;         // mode from radio messages
 extern uint8_t radio_filter;       // filter from radio messages
 extern uint8_t radio_data;       // filter from radio messages
 
-const String retValStr[7] = {
-    "CIV_OK",
-    "CIV_OK_DAV",
-    "CIV_NOK",
-    "CIV_HW_FAULT",
-    "CIV_BUS_BUSY",
-    "CIV_BUS_CONFLICT",
-    "CIV_NO_MSG"
-};
+extern const char * CIV_RetVal_Str(uint8_t retVal);
 
 void changeBands(int8_t direction);
 void pop_win_up(uint8_t win_num);
@@ -90,6 +96,7 @@ void Mute();
 void Menu();
 void Display();
 void Band(uint8_t new_band);
+void Band_Select(uint8_t new_band);
 void BandDn();
 void BandUp();
 void Notch();
@@ -130,7 +137,6 @@ void Zoom(int8_t dir);
 void setZoom(int8_t toggle);
 void PAN(int8_t delta);
 void setPAN(int8_t toggle);
-void digital_step_attenuator_PE4302(int16_t _attn); // Takes a 0 to 100 input, converts to the appropriate hardware steps such as 0-31dB in 1 dB steps
 void setEncoderMode(uint8_t role);
 
 //
@@ -151,6 +157,9 @@ COLD void changeBands(int8_t direction) // neg value is down.  Can jump multiple
     int8_t target_band;
     // TODO search bands column for match to account for mapping that does not start with 0 and bands could be in odd order and disabled.
 
+    if (Band_Guard_Hold(BAND_GUARD_STEP, direction))  // TX active, done after RX and the relay settle time
+        return;
+
     DPRINTF("\nchangeBands: Previous Band was "); DPRINT(bandmem[curr_band].band_name); DPRINTF("  Current Freq: "); DPRINT(VFOA); 
     DPRINTF("  Current Last_VFOA: "); DPRINT(bandmem[curr_band].vfo_A_last); DPRINTF("  Current Mode: "); DPRINT(bandmem[curr_band].mode_A);
     DPRINTF("  Xvtr_Offset: "); DPRINTLN(xvtr_offset);
@@ -188,6 +197,8 @@ COLD void changeBands(int8_t direction) // neg value is down.  Can jump multiple
         }
     }
 
+    if (target_band != curr_band)
+        Xvtr_Profile_Exit(curr_band, target_band);  // save the IF radio settings used on the band we are leaving
     curr_band = target_band; // We have a good band so can new band
     DPRINTF("changeBands: curr_band is "); DPRINT(bandmem[curr_band].band_name); DPRINTF("  Last used VFO on this band: "); DPRINTLN(bandmem[curr_band].vfo_A_last); 
 
@@ -230,11 +241,8 @@ COLD void changeBands(int8_t direction) // neg value is down.  Can jump multiple
     DPRINTF("  Filter: "); DPRINT(bandmem[curr_band].filter_A);
     DPRINTF("  modeList Filter: "); DPRINTLN(modeList[bandmem[curr_band].mode_A].Width);
 
-    // Calculate frequency difference between the designated xvtr IF band's lower edge and the current VFO band's lower edge (the LO frequency).
-    if (bandmem[curr_band].xvtr_IF)
-        xvtr_offset = bandmem[curr_band].edge_lower - bandmem[bandmem[curr_band].xvtr_IF].edge_lower; // if band is 144 then PLL will be set to VFOA-xvtr_offset
-    else
-        xvtr_offset = 0;
+    // Transverter LO for this band, 0 if not a transverter band.  Tuning math is in Xvtr.cpp, this copy is for display.
+    xvtr_offset = Xvtr_LO_Hz(curr_band);
     
     DPRINTF("changeBands: xvtr_offset is "); DPRINTLN(xvtr_offset);
 
@@ -262,21 +270,13 @@ COLD void changeBands(int8_t direction) // neg value is down.  Can jump multiple
     // With tehe need to use a radio band for both direct and transvters uses, we need to control what settings are for each usage
     // Making the remote the master source is the easy answer to all issues so far.
 
-    setMode(3);
-    Check_radio();
-
-    //get_Preamp_from_Radio(); // sync up with radio
-    Preamp(-1); // -1 sets to database state. 2 is toggle state. 0 and 1 are Off and On.  Operate relays if any.
+    // Mode, filter, preamp, attenuator and AGC.  Only the ones the radio does not already have are sent.
+    Radio_Sync_Band(curr_band);
+    Xvtr_Profile_Enter(curr_band);  // RF power, NB, NR and such last used on this transverter band
+    Drive_Limit_Band(curr_band);    // after the profile, it may have restored a higher RF power
+    Atten_Band(curr_band);  // external step attenuator, if fitted
     Check_radio();  // do a check to make sure we service our rx buffer before it overflows.  Normally called in main loop but we are not there yet.
     
-    //get_Attn_from_Radio();  //sync up with radio
-    setAttn(-1); // -1 sets to database state. 2 is toggle state. 0 and 1 are Off and On.  Operate relays if any.
-    Check_radio();
-    
-    //get_AGC_from_Radio();
-    AGC(2);
-    Check_radio();
-    
     get_RIT_from_Radio();
     //send_RIT_to_Radio();   // The offset for XIT and RIT is shared so call this for either one. Only 1 can be enabled at time and they use this value
     get_RIT_ON_OFF_to_Radio();
@@ -284,9 +284,6 @@ COLD void changeBands(int8_t direction) // neg value is down.  Can jump multiple
     get_XIT_ON_OFF_to_Radio();
     //send_XIT_ON_OFF_to_Radio();
 
-    //get_Mode_from_Radio();
-    modeList[bandmem[curr_band].mode_A].Width = bandmem[curr_band].filter_A;  // update width in table to current band last used.
-    send_Mode_to_Radio(bandmem[curr_band].mode_A); // set to last known mode on this band
 
     // will send this later when I add storage for it, for now just read it to prove it works.
     get_DUP_from_Radio();
@@ -300,6 +297,7 @@ COLD void changeBands(int8_t direction) // neg value is down.  Can jump multiple
     
     // converts the current band number to a pattern which is then applied to a group of GPIO pins.
     // You can edit the patern for each band in RadioConfig.h
+    Band_Guard_Switch(curr_band);
     Band_Decode_Output(curr_band);
     
     // Rate(0); Not needed
@@ -525,6 +523,19 @@ COLD void Rate(int8_t dir)
     displayRate();
 }
 
+// Digital modes where the radio only allows AGC FAST.  mndx is a modeList[] index.
+COLD bool AGC_Fast_Only(uint8_t mndx)
+{
+    switch (modeList[mndx].mode_num)
+    {
+        case 0x17:
+        case 0x22:
+        case 0x23:
+        case 0x05:  return true;
+    }
+    return false;
+}
+
 // AGC button
 // ---------------------------AGC() ---------------------------
 //   selects old or new value and updates buttons, labels to match
@@ -570,16 +581,12 @@ COLD void AGC(int8_t dir)
         bandmem[curr_band].agc_mode = (uint8_t) _agc;
     }
     
-    // digital modes only allow AGC Fast
-    switch (modeList[bandmem[curr_band].mode_A].mode_num) // loop though the list look for these modes numbers
+    // digital modes only allow AGC Fast so do not change radio, just update local buttons, labels
+    if (AGC_Fast_Only(bandmem[curr_band].mode_A))
     {
-        case 0x17: // these modes only allow FAST so do nto change radio, just update local buttons, labels
-        case 0x22:
-        case 0x23:
-        case 0x05:  bandmem[curr_band].agc_mode = AGC_FAST;  // force state to FAST, radio does not auto-report AGC changes
-                    dir = 3;  // send only only if not a digital mode - radio is already in FAST in digital modes
-                    DPRINTLNF("AGC(): Changed AGC to FAST for Digital Modes);");
-                    break;
+        bandmem[curr_band].agc_mode = AGC_FAST;  // force state to FAST, radio does not auto-report AGC changes
+        dir = 3;  // send only only if not a digital mode - radio is already in FAST in digital modes
+        DPRINTLNF("AGC(): Changed AGC to FAST for Digital Modes);");
     }
     
     // dir  > 1 just use the unchanged dB value.  
@@ -638,6 +645,9 @@ COLD void VFO_AB(void)
     // feedback beep
     touchBeep(true); // a timer will shut it off.
 
+    if (Band_Guard_Hold(BAND_GUARD_VFO_AB, 0))  // VFO B may be on another band, wait for RX
+        return;
+
     // collect some settings in prep for swapping
     uint64_t old_VFOA  = VFOA;
     uint8_t old_A_mode = bandmem[curr_band].mode_A;
@@ -710,7 +720,7 @@ COLD void setAttn(int8_t toggle)
         bandmem[curr_band].attenuator     = ATTN_ON; // set the attenuator tracking state to ON
     }
 
-    if (toggle == 0 || curr_band > BAND1296)  // preamp and atten not available on IC905 on bands above 1296
+    if (toggle == 0 || !Radio_Model_Front_End(curr_band))  // preamp and atten not available on IC905 on bands above 1296
     {
         bandmem[curr_band].attenuator     = ATTN_OFF; // set attenuator tracking state to OFF
     }
@@ -723,21 +733,24 @@ COLD void setAttn(int8_t toggle)
     // Reading from the radio we just want to update database and screen and not repeat back to radio.
     // 0 = no change to set attenuator level to value in database for this band
     
-    if (curr_band < BAND2400)
+    if (Radio_Model_Front_End(curr_band))
     {
         if (toggle < 3)
         {
             if (bandmem[curr_band].attenuator) 
             {
                 delay(20);
-                CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_ATTN_ON].cmdData), CIV_D_NIX, CIV_wChk);
-                DPRINTF("setAttn: Send to Radio ON: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+                CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_ATTN_ON].cmdData), CIV_D_NIX, CIV_wChk);
+                DPRINTF("setAttn: Send to Radio ON: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
             }
             else
             {
-                CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_ATTN_OFF].cmdData), CIV_D_NIX, CIV_wChk);
-                DPRINTF("setAttn: Send to Radio OFF: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+                CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_ATTN_OFF].cmdData), CIV_D_NIX, CIV_wChk);
+                DPRINTF("setAttn: Send to Radio OFF: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
             }
+            RS_Request(RS_ATTN, bandmem[curr_band].attenuator);
+            if (CIVresultL.retVal == CIV_OK)
+                RS_Acked(RS_ATTN);
         }
     }
     else  // the band is > 1296
@@ -780,7 +793,7 @@ COLD void Attn(int8_t delta)
         bandmem[curr_band].attenuator_dB = _attn = 10;
         setAttn(1);
     }
-    if (_attn <= 0 || curr_band > BAND1296)  // skip for high bands and force off
+    if (_attn <= 0 || !Radio_Model_Front_End(curr_band))  // skip for high bands and force off
     {
         bandmem[curr_band].attenuator_dB = _attn = 0;    
         setAttn(0);
@@ -818,7 +831,7 @@ COLD void Preamp(int8_t toggle)
         bandmem[curr_band].preamp = PREAMP_ON;
     }
 
-    if (toggle == 0 || curr_band > BAND1296) // set to OFF
+    if (toggle == 0 || !Radio_Model_Front_End(curr_band)) // set to OFF
     {
         bandmem[curr_band].preamp = PREAMP_OFF;
     }   
@@ -828,20 +841,23 @@ COLD void Preamp(int8_t toggle)
         bandmem[curr_band].attenuator = ATTN_OFF;   // turn off if attn is on
 
     // Reading from the radio we just want to update database and screen and not repeat back to radio.
-    if (curr_band < BAND2400)
+    if (Radio_Model_Front_End(curr_band))
     {
         if (toggle < 3 )
         {
             if (bandmem[curr_band].preamp) 
             {
-                CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_PREAMP_ON].cmdData), CIV_D_NIX, CIV_wChk);
-                DPRINTF("Preamp: Send to Radio ON: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+                CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_PREAMP_ON].cmdData), CIV_D_NIX, CIV_wChk);
+                DPRINTF("Preamp: Send to Radio ON: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
             }
             else
             {
-                CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_PREAMP_OFF].cmdData), CIV_D_NIX, CIV_wChk);
-                DPRINTF("Preamp: Send to Radio OFF: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+                CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_PREAMP_OFF].cmdData), CIV_D_NIX, CIV_wChk);
+                DPRINTF("Preamp: Send to Radio OFF: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
             }
+            RS_Request(RS_PREAMP, bandmem[curr_band].preamp);
+            if (CIVresultL.retVal == CIV_OK)
+                RS_Acked(RS_PREAMP);
         }
     }
     else  // preamp and atten not available on IC905 on bands above 1296
@@ -913,8 +929,11 @@ COLD void setRIT(int8_t toggle)
 
     if (toggle < 4 )
     {
-            CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(&bandmem[curr_band].RIT_en), CIV_wChk);
-            DPRINTF("Preamp: Send to Radio ON: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+            CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(&bandmem[curr_band].RIT_en), CIV_wChk);
+            DPRINTF("Preamp: Send to Radio ON: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
+            RS_Request(RS_RIT_ON, bandmem[curr_band].RIT_en);
+            if (CIVresultL.retVal == CIV_OK)
+                RS_Acked(RS_RIT_ON);
     }
     
     DPRINTF("setRIT: Set RIT ON/OFF to "); DPRINTLN(bandmem[curr_band].RIT_en);
@@ -948,8 +967,8 @@ COLD void RIT(int8_t delta)
     }
 
     // ToDo: Form up rit_offset to send
-    //CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(rit_offset), CIV_wChk);
-    //DPRINTF("XIT: Send to Radio XIT: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    //CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(rit_offset), CIV_wChk);
+    //DPRINTF("XIT: Send to Radio XIT: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
 
     selectFrequency(0); // no base freq change, just correct for RIT offset
     displayFreq();
@@ -1020,8 +1039,11 @@ COLD void setXIT(int8_t toggle)
 
     if (toggle < 4 )
     {
-            CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(&bandmem[curr_band].XIT_en), CIV_wChk);
-            DPRINTF("setXIT: Send to Radio XIT: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+            CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_XIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(&bandmem[curr_band].XIT_en), CIV_wChk);
+            DPRINTF("setXIT: Send to Radio XIT: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
+            RS_Request(RS_XIT_ON, bandmem[curr_band].XIT_en);
+            if (CIVresultL.retVal == CIV_OK)
+                RS_Acked(RS_XIT_ON);
     }
 
     DPRINTF("setXIT: Set XIT ON/OFF to "); DPRINTLN(bandmem[curr_band].XIT_en);
@@ -1053,8 +1075,8 @@ COLD void XIT(int8_t delta)
     }
 
     // ToDo: Form up xit_offset to send
-    //CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(xit_offset), CIV_wChk);
-    //DPRINTF("XIT: Send to Radio XIT: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    //CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(xit_offset), CIV_wChk);
+    //DPRINTF("XIT: Send to Radio XIT: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     
     selectFrequency(0); // no base freq change, just correct for RIT offset
     displayFreq();
@@ -1517,6 +1539,21 @@ COLD void PAN(int8_t delta)
 // XMIT button
 COLD void Xmit(uint8_t state) // state ->  TX=1, RX=0; Toggle =2
 {
+    if (state != 0 && TX_Timer_Locked())    // first press after a TX timeout only clears the lockout
+    {
+        TX_Timer_Ack();
+        return;
+    }
+    if (state != 0 && Interlock_Latched())  // same for a fault input, only clears once the input is back to normal
+    {
+        Interlock_Clear();
+        return;
+    }
+    if (state != 0 && !Band_Guard_PTT_OK()) // RX forced for a band change, TX again once it is done
+        return;
+    if (state != 0 && !Link_PTT_OK())       // no radio to follow, the band decode may be stale
+        return;
+
     if ((user_settings[user_Profile].xmit == ON && state == 2) || state == 0) // Transmit OFF
     {
         user_settings[user_Profile].xmit = OFF;
@@ -1524,6 +1561,7 @@ COLD void Xmit(uint8_t state) // state ->  TX=1, RX=0; Toggle =2
         {
             digitalWrite(PTT_OUT1, HIGH);  // remove GND
             civ.SetDTR(LOW);  // raise DTR
+            Event_Log_Record(EVT_XMIT, 0, 0);
         }
         // enable line input to pass to headphone jack on audio card, set audio levels
         //TX_RX_Switch(OFF, mode_idx, OFF, OFF, OFF, OFF, 0.5f);
@@ -1533,6 +1571,8 @@ COLD void Xmit(uint8_t state) // state ->  TX=1, RX=0; Toggle =2
         // float   ToneA,          // 0.0f(OFF) or 1.0f (ON)
         // float   ToneB,          // 0.0f(OFF) or 1.0f (ON)
         // float   TestTone_Vol)   // 0.90 is max, clips if higher. Use 0.45f with 2 tones
+        RS_Request(RS_TX, 0);
+        TX_Timer_Update(0, TX_SRC_LOCAL);
         DPRINTLN("XMIT(): TX OFF");
     }
     else if ((user_settings[user_Profile].xmit == OFF && state == 2) || state == 1) // Transmit ON
@@ -1542,9 +1582,11 @@ COLD void Xmit(uint8_t state) // state ->  TX=1, RX=0; Toggle =2
             {
                 digitalWrite(PTT_OUT1, LOW);  // Pull to GND
                 civ.SetDTR(HIGH);  // raise DTR
+                Event_Log_Record(EVT_XMIT, 1, 0);
             }
 
-        //TX_Timeout.reset(); // Reset our Runaway TX timer.  Main loop will watch for this to trip calling back here to flip back to RX.
+        RS_Request(RS_TX, 1);
+        TX_Timer_Update(1, TX_SRC_LOCAL);  // starts the TX timeout, TX_Timer_Service() will call back here to flip back to RX.
 
         // enable mic input to pass to line out on audio card, set audio levels
         //if (TwoToneTest)                                         // do test tones
@@ -1560,6 +1602,45 @@ COLD void Xmit(uint8_t state) // state ->  TX=1, RX=0; Toggle =2
     // DPRINT("Set XMIT to "); DPRINTLN(user_settings[user_Profile].xmit);
 }
 
+// Radio_State listener.  Brings band memory and the screen in line with what the radio reported.
+// The toggle value 3 calls update the labels and buttons without sending anything back to the radio.
+COLD void Radio_State_Changed(uint8_t field, int64_t value)
+{
+    switch (field)
+    {
+        case RS_PREAMP: if (value)
+                        {
+                            bandmem[curr_band].attenuator = ATTN_OFF;   // Only 1 on at a time
+                            bandmem[curr_band].preamp = PREAMP_ON;
+                        }
+                        else
+                            bandmem[curr_band].preamp = PREAMP_OFF;
+                        Preamp(3);
+                        break;
+
+        case RS_ATTN:   if (value)
+                        {
+                            bandmem[curr_band].preamp = PREAMP_OFF;
+                            bandmem[curr_band].attenuator = ATTN_ON;
+                        }
+                        else
+                            bandmem[curr_band].attenuator = ATTN_OFF;
+                        setAttn(3);
+                        break;
+
+        case RS_AGC:    bandmem[curr_band].agc_mode = (uint8_t) value;
+                        AGC(3);
+                        break;
+
+        case RS_SPLIT:  Split(value ? 1 : 0);
+                        break;
+
+        case RS_TX:     user_settings[user_Profile].xmit = value ? ON : OFF;
+                        displayXMIT();
+                        break;
+    }
+}
+
 // NB ON/OFF button
 // -1 is clear meter- used by MF knob and S-meter box
 //  0 is OFF - turn off button highlight and center pan window
@@ -1773,6 +1854,39 @@ COLD void BandDn()
     // DPRINTF("Set Band DN to "); DPRINTLN(bandmem[curr_band].band_num,DEC);
 }
 
+// Band menu selection.  Same band cycles the bandstack, another band loads its last used VFO A.
+COLD void Band_Select(uint8_t new_band)
+{
+    if (Band_Guard_Hold(BAND_GUARD_SELECT, new_band))  // TX active, done after RX and the relay settle time
+        return;
+
+    if (curr_band == new_band) // already on this band so new request must be for bandstack, cycle through, saving changes each time
+    {
+        DPRINT("Band: Previous VFO A on Band ");
+        DPRINTLN(curr_band);
+        uint64_t temp_vfo_last;
+        uint8_t temp_mode_last;
+
+        temp_vfo_last                   = bandmem[curr_band].vfo_A_last; // Save  current freq and mode
+        temp_mode_last                  = bandmem[curr_band].mode_A;
+        bandmem[curr_band].vfo_A_last   = bandmem[curr_band].vfo_A_last_1; // shuffle previous up to curent
+        bandmem[curr_band].mode_A       = bandmem[curr_band].mode_A_1;
+        bandmem[curr_band].vfo_A_last_1 = bandmem[curr_band].vfo_A_last_2; // shuffle more
+        bandmem[curr_band].mode_A_1     = bandmem[curr_band].mode_A_2;
+        bandmem[curr_band].vfo_A_last_2 = temp_vfo_last; // let changeBands compute new band based on VFO frequency
+        bandmem[curr_band].mode_A_2     = temp_mode_last;
+        BStack_Rotate(curr_band);                                          // freshness follows the entries
+        VFOA                            = bandmem[curr_band].vfo_A_last; // store in the Active VFO register
+    }
+    else
+    {
+        DPRINT("Band: Last VFO A on Band ");
+        DPRINTLN(new_band);
+        VFOA = bandmem[new_band].vfo_A_last; // let changeBands compute new band based on VFO frequency
+    }
+    changeBands(0);
+}
+
 // BAND button
 // Bandstack will copy in one of the alternative saved VFOA values and cycle throgh them.  VFO_A_last is always the last active value. Last_1 the previous, and last_2 previous to that.
 COLD void Band(uint8_t new_band)
@@ -1780,32 +1894,7 @@ COLD void Band(uint8_t new_band)
     if (std_btn[BAND_BTN].enabled == ON)
     {
         if (popup && new_band != 255)
-        {
-            if (curr_band == new_band) // already on this band so new request must be for bandstack, cycle through, saving changes each time
-            {
-                DPRINT("Band: Previous VFO A on Band ");
-                DPRINTLN(curr_band);
-                uint64_t temp_vfo_last;
-                uint8_t temp_mode_last;
-
-                temp_vfo_last                   = bandmem[curr_band].vfo_A_last; // Save  current freq and mode
-                temp_mode_last                  = bandmem[curr_band].mode_A;
-                bandmem[curr_band].vfo_A_last   = bandmem[curr_band].vfo_A_last_1; // shuffle previous up to curent
-                bandmem[curr_band].mode_A       = bandmem[curr_band].mode_A_1;
-                bandmem[curr_band].vfo_A_last_1 = bandmem[curr_band].vfo_A_last_2; // shuffle more
-                bandmem[curr_band].mode_A_1     = bandmem[curr_band].mode_A_2;
-                bandmem[curr_band].vfo_A_last_2 = temp_vfo_last; // let changeBands compute new band based on VFO frequency
-                bandmem[curr_band].mode_A_2     = temp_mode_last;
-                VFOA                            = bandmem[curr_band].vfo_A_last; // store in the Active VFO register
-            }
-            else
-            {
-                DPRINT("Band: Last VFO A on Band ");
-                DPRINTLN(new_band);
-                VFOA = bandmem[new_band].vfo_A_last; // let changeBands compute new band based on VFO frequency
-            }
-            changeBands(0);
-        }
+            Band_Select(new_band);
         std_btn[BAND_BTN].enabled = OFF;
         displayBand_Menu(0); // Exit window
     }
@@ -1966,82 +2055,14 @@ void setEncoderMode(uint8_t role)
     }
 }
 
-// Takes a 0 to 100 input, converts to the appropriate hardware steps such as 0-31dB in 1 dB steps
-// Code is for the PE4302 digital step attenuator
-// Can clone and modify this for other hardware, call it from teh ATTN() function
-COLD void digital_step_attenuator_PE4302(int16_t _attn)
-{
-    #ifndef PE4302
-        DPRINTLN(F("PE4302 digital step attenuator not configured, skipping"));
-        return; // Wrong hardware if not PE4302
-    #else
-
-    const uint8_t atten_size_31 = 62;  // 62 steps  31dB in 0.5 dB steps. Use 31 for 1dB steps
-  
-    char atten_str[8]  = {'\0'};
-    char atten_data[8] = {'\0'};
-    uint8_t i;
-    int16_t attn;
-
-    // scale 0 to 100% to size of attenuator hardware.  Assuming 0 to 31dB here.
-    attn = round(((_atten * atten_size_31 / 100) - 0.5)); // round down to get 0-31 range
-
-    if (attn >= atten_size_31) // will crash is exceed 0 to 31!
-        attn = atten_size_31;
-    if (attn < 0)
-        attn = 0;
-
-    //DPRINT("digital step converted = ");DPRINTLN(attn);
-
-    // comment out for 0.5dB steps
-    //attn *= 2; // shift the value x2 so the LSB controls the 1dB step.
-
-    /* Convert to 8 bits of  0 and 1 format */
-    itoa(attn, atten_str, 2);
-    //DPRINTLN(atten_str);   // should be 6 bits of binary in the range of 0 to 64
-    
-    // Convert to 6 bits of  0 and 1 format 
-    // pad with leading 0s as needed.  6 bits for the PE4302 + '\0' at end for 7 bytes
-    //snprintf(atten_data, 7, "%06s", atten_str);   // works but get compiler warning for 0 and string together    
-    for (i = 0; (i < 6 - strlen(atten_str)); i++)
-    {
-        atten_data[i] = '0';
-    }
-    strncat(atten_data, atten_str, strlen(atten_str));
-    //DPRINTLN(atten_data);   // should be 6 bits of binary in the range of 0 to 64
-
-    //  LE = 0 to allow writing data into shift register
-    digitalWrite(Atten_LE, (uint8_t)OFF);
-    digitalWrite(Atten_DATA, (uint8_t)OFF);
-    digitalWrite(Atten_CLK, (uint8_t)OFF);
-    delayMicroseconds(10);
- 
-    //  Now loop for 6 bits, set data on Data pin and toggle Clock pin.
-    //    Start with the MSB first so start at the left end of the string
-    for (i = 0; i < 6; i++)
-    {
-        // convert ascii 0 or 1 to a decimal 0 or 1
-            digitalWrite(Atten_DATA, (uint8_t) atten_data[i]-48);
-            delayMicroseconds(10);
-            digitalWrite(Atten_CLK,  (uint8_t) ON);
-            delayMicroseconds(10);
-            digitalWrite(Atten_CLK,  (uint8_t) OFF); 
-            delayMicroseconds(10);
-        }
-        //  Toggle LE pin to latch the data and set the new attenuation value in the hardware
-        digitalWrite(Atten_LE, (uint8_t) ON);
-        delayMicroseconds(10);
-        digitalWrite(Atten_LE, (uint8_t) OFF);
-    #endif
-}
-
 //
 // Changes to the correct band settings for the new target frequency.
 // If the new frequency is below or above the band limits it returns 0 else returns the new frequency
 //
 #define DBG_BAND
-HOT uint64_t find_new_band(uint64_t new_frequency, uint8_t &_curr_band)
+PLACE(find_new_band) uint64_t find_new_band(uint64_t new_frequency, uint8_t &_curr_band)
 {
+    PROF(find_new_band);
     int i;
 
     #ifdef DBG_BAND
@@ -2066,11 +2087,8 @@ HOT uint64_t find_new_band(uint64_t new_frequency, uint8_t &_curr_band)
                 DPRINTF("find_band(): Keep existing VFOA request and use New Band = "); DPRINTLN(_curr_band);
             #endif
             
-            //  Calculate frequency difference between the designated xvtr IF band's lower edge and the current VFO band's lower edge (the LO frequency).
-            if (bandmem[_curr_band].xvtr_IF)
-                xvtr_offset = bandmem[_curr_band].edge_lower - bandmem[bandmem[_curr_band].xvtr_IF].edge_lower; // if band is 144 then PLL will be set to VFOA-xvtr_offset
-            else
-                xvtr_offset = 0;
+            // Transverter LO for this band, 0 if not a transverter band
+            xvtr_offset = Xvtr_LO_Hz(_curr_band);
             
             #ifdef DBG_BAND
                 DPRINTF("find_band(): New Xvtr_offset = "); DPRINTLN(xvtr_offset);   // IS this happening twiew, always?  maybe redundant
@@ -2123,8 +2141,10 @@ COLD uint8_t get_Mode_from_Radio(void)
 {
     CIVresult_t CIVresultL_mode;
 
-    CIVresultL_mode = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(cmd_List[CIV_C_F26A].cmdData), CIV_D_NIX, CIV_wChk);
-    //DPRINTF("get_Mode_from_Radio: retVal of Mode cmd writeMsg: "); DPRINTLN(retValStr[CIVresultL_mode.retVal]);
+    if (!Radio_Model_Has(RM_CMD_F26))  // IC7100, the mode reports are all there is
+        return CIV_NOK;
+    CIVresultL_mode = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(cmd_List[CIV_C_F26A].cmdData), CIV_D_NIX, CIV_wChk);
+    //DPRINTF("get_Mode_from_Radio: retVal of Mode cmd writeMsg: "); DPRINTLN(CIV_RetVal_Str(CIVresultL_mode.retVal));
     Check_radio();
     return CIVresultL_mode.retVal;
 }
@@ -2187,23 +2207,32 @@ COLD void send_Mode_to_Radio(uint8_t mndx)
 
     // Populate the datafield
     data_str[0] = 3;  // send the mode values
-    data_str[1] = radio_mode;  // send the mode values
+    data_str[1] = Xvtr_Radio_Mode(curr_band, radio_mode);  // send the mode values.  Sideband flips on a high side LO transverter
     data_str[2] = radio_data;  // set DATA on or off 
     data_str[3] = radio_filter;  // Set filter
     
     //DPRINTF("send_Mode_to_Radio: Mode: "); DPRINT(modeList[mndx].mode_label); DPRINTF("  Filter: "); DPRINT(filter[radio_filter].Filter_name); DPRINTF("    Data: "); DPRINTLN(radio_data);    
 
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_F26A].cmdData), reinterpret_cast<const uint8_t*>(data_str), CIV_wChk);
-    //CIVresultL_vfo = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_MOD_READ].cmdData), reinterpret_cast<const uint8_t*>(data_str), CIV_wChk);
-    //CIVresultL_vfo = civ.writeMsg(CIV_ADDR, data_str, CIV_D_NIX, CIV_wChk);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_F26A].cmdData), reinterpret_cast<const uint8_t*>(data_str), CIV_wChk);
+    RS_Request(RS_MODE, mndx);
+    RS_Request(RS_FILTER, radio_filter);
+    RS_Request(RS_DATA, radio_data);
+    if (CIVresultL.retVal == CIV_OK)
+    {
+        RS_Acked(RS_MODE);
+        RS_Acked(RS_FILTER);
+        RS_Acked(RS_DATA);
+    }
+    //CIVresultL_vfo = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_MOD_READ].cmdData), reinterpret_cast<const uint8_t*>(data_str), CIV_wChk);
+    //CIVresultL_vfo = civ.writeMsg(radio_addr, data_str, CIV_D_NIX, CIV_wChk);
     //while (CIVresultL_vfo.retVal > CIV_OK_DAV)
     //{
     //    delay(40);
-    //    CIVresultL_vfo = civ.writeMsg(CIV_ADDR, data_str, CIV_D_NIX, CIV_wChk);
-    //    DPRINTF("send_Mode_to_Radio: delay loop ret = "); DPRINTLN(retValStr[CIVresultL_vfo.retVal]);  
+    //    CIVresultL_vfo = civ.writeMsg(radio_addr, data_str, CIV_D_NIX, CIV_wChk);
+    //    DPRINTF("send_Mode_to_Radio: delay loop ret = "); DPRINTLN(CIV_RetVal_Str(CIVresultL_vfo.retVal));  
     //}
     
-    //DPRINTF("send_Mode_to_Radio: retVal of Mode cmd writeMsg: "); DPRINTLN(retValStr[CIVresultL.retVal]);
+    //DPRINTF("send_Mode_to_Radio: retVal of Mode cmd writeMsg: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     
     if (CIVresultL.retVal == CIV_OK)
     {
@@ -2230,8 +2259,8 @@ COLD uint8_t read_BSTACK_from_Radio(uint8_t band, uint8_t reg)   // Ask the radi
     data_str[1] = band;  // send the mode values
     data_str[2] = reg;  // send the mode values
 
-    CIVresultL_vfo = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_BSTACK].cmdData), reinterpret_cast<const uint8_t*>(data_str), CIV_wChk);
-    //DPRINTF("read_BSTACK_from_Radio: retVal of BSTACK writeMsg: "); DPRINTLN(retValStr[CIVresultL_vfo.retVal]);
+    CIVresultL_vfo = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_BSTACK].cmdData), reinterpret_cast<const uint8_t*>(data_str), CIV_wChk);
+    //DPRINTF("read_BSTACK_from_Radio: retVal of BSTACK writeMsg: "); DPRINTLN(CIV_RetVal_Str(CIVresultL_vfo.retVal));
     delay(20);
     Check_radio();
     if (CIVresultL_vfo.retVal == CIV_OK)
@@ -2247,8 +2276,8 @@ COLD uint64_t get_Freq_from_Radio(void)   // Change Mode of the current active V
 {
     CIVresult_t CIVresultL;
 
-    CIVresultL = civ.writeMsg(CIV_ADDR, cmd_List[CIV_C_F_READ].cmdData, CIV_D_NIX, CIV_wChk);  // kick off freq request to update from radio
-    //DPRINTF("get_Freq_from_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, cmd_List[CIV_C_F_READ].cmdData, CIV_D_NIX, CIV_wChk);  // kick off freq request to update from radio
+    //DPRINTF("get_Freq_from_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     //return CIVresultL.value;  // return 
     delay(20);
     Check_radio();
@@ -2260,8 +2289,8 @@ COLD uint8_t get_RXTX_from_Radio(void)   // Change Mode of the current active VF
 {
     CIVresult_t CIVresultL;
 
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_TX].cmdData), CIV_D_NIX, CIV_wChk);
-    //DPRINTF("get_RXTX_from_Radio: retVal of RX TX: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_TX].cmdData), CIV_D_NIX, CIV_wChk);
+    //DPRINTF("get_RXTX_from_Radio: retVal of RX TX: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     Check_radio();
     return CIVresultL.value;
 }
@@ -2271,18 +2300,15 @@ COLD uint8_t get_MY_POSITION_from_Radio(void)
 {
     CIVresult_t CIVresultL;
 
-    if (CIV_ADDR == CIV_ADDR_705)
-      CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_UTC_READ_705].cmdData), CIV_D_NIX, CIV_wChk);
-    else if (CIV_ADDR == CIV_ADDR_905)
-      CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_UTC_READ_905].cmdData), CIV_D_NIX, CIV_wChk);
-    else
+    if (!Radio_Model_Has(RM_CMD_UTC) || !Radio_Model_Has(RM_CMD_GPS))
       return 0;
-    DPRINTF("get_MY_POSITION_from_Radio: retVal of UTC Offset: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[Radio_Model_Get()->utc_cmd].cmdData), CIV_D_NIX, CIV_wChk);
+    DPRINTF("get_MY_POSITION_from_Radio: retVal of UTC Offset: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     delay(60);
     check_CIV(millis());  // give time to respond -  Msg_type 3 is bstack results
     
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_MY_POSIT_READ].cmdData), CIV_D_NIX, CIV_wChk);
-    DPRINTF("get_MY_POSITION_from_Radio: retVal of MY POS: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_MY_POSIT_READ].cmdData), CIV_D_NIX, CIV_wChk);
+    DPRINTF("get_MY_POSITION_from_Radio: retVal of MY POS: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     delay(60);
     check_CIV(millis());  // give time to respond -  Msg_type 3 is bstack results
 
@@ -2294,17 +2320,17 @@ COLD uint8_t get_Preamp_from_Radio(void)
 {
     CIVresult_t CIVresultL;
 
-    if (curr_band < BAND2400)  // IC905 does not have Attn or Preamp on bands > 1296
+    if (Radio_Model_Front_End(curr_band))  // no Attn or Preamp on this band, IC905 above 1296
     {
-        CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_PREAMP_READ].cmdData), CIV_D_NIX, CIV_wChk);
-        //DPRINTF("get_PreAmp_from_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+        CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_PREAMP_READ].cmdData), CIV_D_NIX, CIV_wChk);
+        //DPRINTF("get_PreAmp_from_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
         delay(20);
         Check_radio();
         return CIVresultL.value;
     }
     else
     {
-        DPRINTLNF("get_Preamp_from_Radio: skipping for bands > 1296");
+        DPRINTLNF("get_Preamp_from_Radio: none on this band, skipping");
     }
     return 0;
 }
@@ -2314,17 +2340,17 @@ COLD uint8_t get_Attn_from_Radio(void)
 {
     CIVresult_t CIVresultL;
 
-    if (curr_band < BAND2400)  // IC905 does not have Attn or Preamp on bands > 1296
+    if (Radio_Model_Front_End(curr_band))  // no Attn or Preamp on this band, IC905 above 1296
     {
-        CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_ATTN_READ].cmdData), CIV_D_NIX, CIV_wChk);
-        //DPRINTF("get_Attn_from_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+        CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_ATTN_READ].cmdData), CIV_D_NIX, CIV_wChk);
+        //DPRINTF("get_Attn_from_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
         delay(20);
         Check_radio();
         return CIVresultL.value;
     }
     else
     {
-        DPRINTLNF("get_Attn_from_Radio: skipping for bands > 1296");
+        DPRINTLNF("get_Attn_from_Radio: none on this band, skipping");
     }
     return 0;
 }
@@ -2334,8 +2360,8 @@ COLD uint8_t get_AGC_from_Radio(void)
 {
     CIVresult_t CIVresultL;
 
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_AGC_READ].cmdData), CIV_D_NIX, CIV_wChk);
-    //DPRINTF("get_AGC_from_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_AGC_READ].cmdData), CIV_D_NIX, CIV_wChk);
+    //DPRINTF("get_AGC_from_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     delay(20);
     Check_radio();
     return CIVresultL.value;
@@ -2347,8 +2373,11 @@ COLD uint8_t send_AGC_to_Radio(void)
     CIVresult_t CIVresultL;
     
     cmd_List[CIV_C_AGC_FAST].cmdData[3] = bandmem[curr_band].agc_mode;
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_AGC_FAST].cmdData), CIV_D_NIX, CIV_wChk);
-    //DPRINTF("send_AGC_to_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_AGC_FAST].cmdData), CIV_D_NIX, CIV_wChk);
+    RS_Request(RS_AGC, bandmem[curr_band].agc_mode);
+    if (CIVresultL.retVal == CIV_OK)
+        RS_Acked(RS_AGC);
+    //DPRINTF("send_AGC_to_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     delay(20);
     Check_radio();
     return CIVresultL.value;
@@ -2359,7 +2388,7 @@ uint8_t send_CIV_WakeUp_to_Radio(void)
 {
     CIVresult_t CIVresultL;
     
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RADIO_ON].cmdData), CIV_D_NIX, CIV_wOn);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RADIO_ON].cmdData), CIV_D_NIX, CIV_wOn);
     return CIVresultL.value;
 }
 
@@ -2368,8 +2397,8 @@ COLD uint8_t get_DUP_from_Radio(void)
 {
     CIVresult_t CIVresultL;
     
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_DUPLEX_READ].cmdData), CIV_D_NIX, CIV_wChk);
-    //DPRINTF("get_DUP_from_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_DUPLEX_READ].cmdData), CIV_D_NIX, CIV_wChk);
+    //DPRINTF("get_DUP_from_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     delay(20);
     Check_radio();
     return CIVresultL.value;
@@ -2381,8 +2410,8 @@ COLD uint8_t send_DUP_to_Radio(void)
     //CIVresult_t CIVresultL;
     
     //cmd_List[CIV_C_AGC_FAST].cmdData[3] = bandmem[curr_band].XXXXX;
-    //CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_DUPLEX_SEND].cmdData), CIV_D_NIX, CIV_wChk);
-    //DPRINTF("send_DUP_to_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    //CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_DUPLEX_SEND].cmdData), CIV_D_NIX, CIV_wChk);
+    //DPRINTF("send_DUP_to_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     //Check_radio();
     //return CIVresultL.value;
     return 0;
@@ -2393,22 +2422,23 @@ COLD uint8_t get_RIT_from_Radio(void)
 {
     CIVresult_t CIVresultL;
     
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_XIT].cmdData), CIV_D_NIX, CIV_wChk);
-    //DPRINTF("get_RIT_from_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_XIT].cmdData), CIV_D_NIX, CIV_wChk);
+    //DPRINTF("get_RIT_from_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     delay(20);
     Check_radio();
     return CIVresultL.value;
 }
 
 // Used to set RIT Offset status on radio  -  This is also used for XIT Offset
+// Same layout the radio reports: 10/1Hz, 1k/100Hz in BCD then 01 for minus.  Goes through write combining for the knob.
 COLD uint8_t send_RIT_to_Radio(void)
 {
-    CIVresult_t CIVresultL;
+    uint16_t _offset = abs(rit_offset);
+    uint8_t data_str[4] = {3, bcdByteEncode(_offset % 100), bcdByteEncode(_offset / 100 % 100), (uint8_t) (rit_offset < 0)};
     
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_XIT].cmdData), reinterpret_cast<const uint8_t*>(rit_offset), CIV_wChk);
-    //DPRINTF("send_RIT_to_Radio: retVal: "); DPRINT(retValStr[CIVresultL.value]);  DPRINTF("  RIT Offset = "); DPRINTLN(rit_offset);
-    Check_radio();
-    return CIVresultL.value;
+    WC_Write(reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_XIT].cmdData), data_str, WC_RIT_SPACING_MS, CIV_wFast);
+    //DPRINTF("send_RIT_to_Radio: RIT Offset = "); DPRINTLN(rit_offset);
+    return 0;
 }
 
 // Used to set RIT Offset status on radio
@@ -2417,8 +2447,8 @@ COLD uint8_t send_RIT_ON_OFF_to_Radio(void)
     CIVresult_t CIVresultL;
     
     //cmd_List[CIV_C_RIT_ON_OFF].cmdData[3] = bandmem[curr_band].RIT_en;
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(&bandmem[curr_band].RIT_en), CIV_wChk);
-    //DPRINTF("send_RIT_ON_OFF_to_Radio: retVal: "); DPRINT(retValStr[CIVresultL.value]);  DPRINTF("  RIT On/Off = "); DPRINTLN(bandmem[curr_band].RIT_en);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(&bandmem[curr_band].RIT_en), CIV_wChk);
+    //DPRINTF("send_RIT_ON_OFF_to_Radio: retVal: "); DPRINT(CIV_RetVal_Str(CIVresultL.value));  DPRINTF("  RIT On/Off = "); DPRINTLN(bandmem[curr_band].RIT_en);
     delay(20);
     Check_radio();
     return CIVresultL.value;
@@ -2429,8 +2459,8 @@ COLD uint8_t get_RIT_ON_OFF_to_Radio(void)
 {
     CIVresult_t CIVresultL;
     
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), CIV_D_NIX, CIV_wChk);
-    //DPRINTF("get_RIT_ON_OFF_to_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RIT_ON_OFF].cmdData), CIV_D_NIX, CIV_wChk);
+    //DPRINTF("get_RIT_ON_OFF_to_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     delay(20);
     Check_radio();
     return CIVresultL.value;
@@ -2441,8 +2471,8 @@ COLD uint8_t send_XIT_ON_OFF_to_Radio(void)
 {
     CIVresult_t CIVresultL;
     
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_XIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(&bandmem[curr_band].XIT_en), CIV_wChk);
-    //DPRINTF("send_XIT_ON_OFF_to_Radio: retVal: "); DPRINT(retValStr[CIVresultL.value]);  DPRINTF("  XIT On/Off = "); DPRINTLN(bandmem[curr_band].XIT_en);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_XIT_ON_OFF].cmdData), reinterpret_cast<const uint8_t*>(&bandmem[curr_band].XIT_en), CIV_wChk);
+    //DPRINTF("send_XIT_ON_OFF_to_Radio: retVal: "); DPRINT(CIV_RetVal_Str(CIVresultL.value));  DPRINTF("  XIT On/Off = "); DPRINTLN(bandmem[curr_band].XIT_en);
     delay(20);
     Check_radio();
     return CIVresultL.value;
@@ -2453,8 +2483,8 @@ COLD uint8_t get_XIT_ON_OFF_to_Radio(void)
 {
     CIVresult_t CIVresultL;
     
-    CIVresultL = civ.writeMsg(CIV_ADDR, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_XIT_ON_OFF].cmdData), CIV_D_NIX, CIV_wChk);
-    //DPRINTF("get_XIT_ON_OFF_to_Radio: retVal: "); DPRINTLN(retValStr[CIVresultL.value]);
+    CIVresultL = civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_XIT_ON_OFF].cmdData), CIV_D_NIX, CIV_wChk);
+    //DPRINTF("get_XIT_ON_OFF_to_Radio: retVal: "); DPRINTLN(CIV_RetVal_Str(CIVresultL.retVal));
     delay(20);
     Check_radio();
     return CIVresultL.value;
@@ -2472,51 +2502,26 @@ void Band_Decode_Output(uint8_t band)
 
     DPRINTF("Band_Decode_Output: Band: "); DPRINTLN(band);
 
-    switch (band)
-    {
-       case  BAND160M : GPIO_Out(DECODE_BAND160M); break;   //160M 
-       case  BAND80M  : GPIO_Out(DECODE_BAND80M);  break;   //80M
-       case  BAND60M  : GPIO_Out(DECODE_BAND60M);  break;   //60M
-       case  BAND40M  : GPIO_Out(DECODE_BAND40M);  break;   //40M
-       case  BAND30M  : GPIO_Out(DECODE_BAND30M);  break;   //30M
-       case  BAND20M  : GPIO_Out(DECODE_BAND20M);  break;   //20M
-       case  BAND17M  : GPIO_Out(DECODE_BAND17M);  break;   //17M      
-       case  BAND15M  : GPIO_Out(DECODE_BAND15M);  break;   //15M
-       case  BAND12M  : GPIO_Out(DECODE_BAND12M);  break;   //12M
-       case  BAND10M  : GPIO_Out(DECODE_BAND10M);  break;   //10M
-       case  BAND6M   : GPIO_Out(DECODE_BAND6M);   break;   //6M
-        //case BAND70   : GPIO_Out(0x01); break;   //6M
-       case  BAND144  : GPIO_Out(DECODE_BAND144);  break;   //2M
-       case  BAND222  : GPIO_Out(DECODE_BAND222);  break;   //222
-       case  BAND432  : GPIO_Out(DECODE_BAND432);  break;   //432
-       case  BAND902  : GPIO_Out(DECODE_BAND902);  break;   //902
-       case  BAND1296 : GPIO_Out(DECODE_BAND1296); break;   //1296
-       case  BAND2400 : GPIO_Out(DECODE_BAND2400); break;   //2400
-       case  BAND3400 : GPIO_Out(DECODE_BAND3400); break;   //3400
-       case  BAND5760 : GPIO_Out(DECODE_BAND5760); break;   //5760M
-       case  BAND10G  : GPIO_Out(DECODE_BAND10G);  break;   //10.368.1G
-       case  BAND24G  : GPIO_Out(DECODE_BAND24G);  break;   //24.192G
-       case  BAND47G  : GPIO_Out(DECODE_BAND47G);  break;   //47.1G
-       case  BAND76G  : GPIO_Out(DECODE_BAND76G);  break;   //76.1G
-       case  BAND122G : GPIO_Out(DECODE_BAND122G); break;   //122G
+    if (band < BAND_DECODE_ROWS)
+    {
+        GPIO_Out(band_decode_table[band].decode);
+        Event_Log_Record(EVT_BAND, band, band_decode_table[band].decode);
     }
 }
 
+static uint8_t gpio_out_last = 0;
+static uint8_t ptt_out_last  = 0;
+
 void GPIO_Out(uint8_t pattern)
 {
+    gpio_out_last = pattern;
     DPRINTF("GPIO_Out: pattern:  DEC "); DPRINT(pattern);
     DPRINTF("  HEX "); DPRINT(pattern, HEX);
     DPRINTF("  Binary "); DPRINTLN(pattern, BIN);
 
     // mask each bit and apply the 1 or 0 to the assigned pin
-    if (BAND_DECODE_OUTPUT_PIN_0 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_OUTPUT_PIN_0, pattern & 0x01);  // bit 0
-    if (BAND_DECODE_OUTPUT_PIN_1 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_OUTPUT_PIN_1, pattern & 0x02);  // bit 1
-    if (BAND_DECODE_OUTPUT_PIN_2 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_OUTPUT_PIN_2, pattern & 0x04);  // bit 2
-    if (BAND_DECODE_OUTPUT_PIN_3 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_OUTPUT_PIN_3, pattern & 0x08);  // bit 3
-    if (BAND_DECODE_OUTPUT_PIN_4 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_OUTPUT_PIN_4, pattern & 0x10);  // bit 4
-    if (BAND_DECODE_OUTPUT_PIN_5 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_OUTPUT_PIN_5, pattern & 0x20);  // bit 5
-    if (BAND_DECODE_OUTPUT_PIN_6 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_OUTPUT_PIN_6, pattern & 0x40);  // bit 6
-    if (BAND_DECODE_OUTPUT_PIN_7 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_OUTPUT_PIN_7, pattern & 0x80);  // bit 7
+    for (uint8_t i = 0; i < BAND_DECODE_BITS; i++)
+        if (band_decode_pins[i] != GPIO_PIN_NOT_USED) digitalWrite(band_decode_pins[i], pattern & (1 << i));
 }
 
 void PTT_Output(uint8_t band, uint8_t PTT_state)
@@ -2524,52 +2529,58 @@ void PTT_Output(uint8_t band, uint8_t PTT_state)
     // Set your desired PTT pattern per band in RadioConfig.h
     // ToDo: Eventually create a local UI screen to edit and monitor pin states
 
-    DPRINTF("Band_Decode_Output: Band: "); DPRINTLN(band);
+    DPRINTF("PTT_Output: Band: "); DPRINTLN(band);
 
-    switch (band)
-    {
-       case  BAND160M : GPIO_PTT_Out(DECODE_BAND160M_PTT, PTT_state); break;  //160M 
-       case  BAND80M  : GPIO_PTT_Out(DECODE_BAND80M_PTT, PTT_state); break;   //80M
-       case  BAND60M  : GPIO_PTT_Out(DECODE_BAND60M_PTT, PTT_state); break;   //60M
-       case  BAND40M  : GPIO_PTT_Out(DECODE_BAND40M_PTT, PTT_state); break;   //40M
-       case  BAND30M  : GPIO_PTT_Out(DECODE_BAND30M_PTT, PTT_state); break;   //30M
-       case  BAND20M  : GPIO_PTT_Out(DECODE_BAND20M_PTT, PTT_state); break;   //20M
-       case  BAND17M  : GPIO_PTT_Out(DECODE_BAND17M_PTT, PTT_state); break;   //17M      
-       case  BAND15M  : GPIO_PTT_Out(DECODE_BAND15M_PTT, PTT_state); break;   //15M
-       case  BAND12M  : GPIO_PTT_Out(DECODE_BAND12M_PTT, PTT_state); break;   //12M
-       case  BAND10M  : GPIO_PTT_Out(DECODE_BAND10M_PTT, PTT_state); break;   //10M
-       case  BAND6M   : GPIO_PTT_Out(DECODE_BAND6M_PTT, PTT_state); break;    //6M
-        //case BAND70   : GPIO_PTT_Out(0x01_PTT, PTT_state); break;   //6M
-       case  BAND144  : GPIO_PTT_Out(DECODE_BAND144_PTT, PTT_state); break;   //2M
-       case  BAND222  : GPIO_PTT_Out(DECODE_BAND222_PTT, PTT_state); break;   //222
-       case  BAND432  : GPIO_PTT_Out(DECODE_BAND432_PTT, PTT_state); break;   //432
-       case  BAND902  : GPIO_PTT_Out(DECODE_BAND902_PTT, PTT_state); break;   //902
-       case  BAND1296 : GPIO_PTT_Out(DECODE_BAND1296_PTT, PTT_state); break;  //1296
-       case  BAND2400 : GPIO_PTT_Out(DECODE_BAND2400_PTT, PTT_state); break;  //2400
-       case  BAND3400 : GPIO_PTT_Out(DECODE_BAND3400_PTT, PTT_state); break;  //3400
-       case  BAND5760 : GPIO_PTT_Out(DECODE_BAND5760_PTT, PTT_state); break;  //5760M
-       case  BAND10G  : GPIO_PTT_Out(DECODE_BAND10G_PTT, PTT_state); break;   //10.368.1G
-       case  BAND24G  : GPIO_PTT_Out(DECODE_BAND24G_PTT, PTT_state); break;   //24.192G
-       case  BAND47G  : GPIO_PTT_Out(DECODE_BAND47G_PTT, PTT_state); break;   //47.1G
-       case  BAND76G  : GPIO_PTT_Out(DECODE_BAND76G_PTT, PTT_state); break;   //76.1G
-       case  BAND122G : GPIO_PTT_Out(DECODE_BAND122G_PTT, PTT_state); break;  //122G
+    Drive_Limit_PTT(band, PTT_state);   // a held TX request is released once the drive level is confirmed
+    if (PTT_state && !Drive_Limit_PTT_OK(band))
+    {
+        DPRINTLNF("PTT_Output: held in RX, RF power not confirmed at or below the band drive limit");
+        PTT_state = 0;
+    }
+    if (PTT_state && !Interlock_PTT_OK())
+    {
+        DPRINTLNF("PTT_Output: held in RX, interlock fault");
+        PTT_state = 0;
+    }
+    if (PTT_state && !Band_Guard_PTT_OK())
+    {
+        DPRINTLNF("PTT_Output: held in RX, band change pending");
+        PTT_state = 0;
+    }
+    if (PTT_state && !Link_PTT_OK())
+    {
+        DPRINTLNF("PTT_Output: held in RX, CI-V link lost");
+        PTT_state = 0;
+    }
+    Band_Guard_PTT(PTT_state);
+
+    if (band < BAND_DECODE_ROWS)
+        GPIO_PTT_Out(band_decode_table[band].decode_ptt, PTT_state);
+    if (PTT_state != ptt_out_last)
+    {
+        ptt_out_last = PTT_state;
+        Event_Log_Record(EVT_PTT, PTT_state, band);
     }
 }
 
+uint8_t GPIO_Out_Get(void)
+{
+    return gpio_out_last;
+}
+
+uint8_t PTT_Output_Get(void)
+{
+    return ptt_out_last;
+}
+
 void GPIO_PTT_Out(uint8_t pattern, uint8_t PTT_state)
 {
     DPRINTF("  PTT state "); DPRINT(PTT_state, BIN);
-    DPRINTF("  PTT Output Binary "); DPRINTLN(pattern & PTT_state, BIN);
+    DPRINTF("  PTT Output Binary "); DPRINTLN(PTT_state ? pattern : 0, BIN);
 
-    // mask each bit and apply the 1 or 0 to the assigned pin
-    if (BAND_DECODE_PTT_OUTPUT_PIN_0 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_PTT_OUTPUT_PIN_0, pattern & 0x01 & PTT_state);  // bit 0
-    if (BAND_DECODE_PTT_OUTPUT_PIN_1 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_PTT_OUTPUT_PIN_1, pattern & 0x02 & PTT_state);  // bit 1
-    if (BAND_DECODE_PTT_OUTPUT_PIN_2 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_PTT_OUTPUT_PIN_2, pattern & 0x04 & PTT_state);  // bit 2
-    if (BAND_DECODE_PTT_OUTPUT_PIN_3 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_PTT_OUTPUT_PIN_3, pattern & 0x08 & PTT_state);  // bit 3
-    if (BAND_DECODE_PTT_OUTPUT_PIN_4 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_PTT_OUTPUT_PIN_4, pattern & 0x10 & PTT_state);  // bit 4
-    if (BAND_DECODE_PTT_OUTPUT_PIN_5 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_PTT_OUTPUT_PIN_5, pattern & 0x20 & PTT_state);  // bit 5
-    if (BAND_DECODE_PTT_OUTPUT_PIN_6 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_PTT_OUTPUT_PIN_6, pattern & 0x40 & PTT_state);  // bit 6
-    if (BAND_DECODE_PTT_OUTPUT_PIN_7 != GPIO_PIN_NOT_USED) digitalWrite(BAND_DECODE_PTT_OUTPUT_PIN_7, pattern & 0x80 & PTT_state);  // bit 7
+    // mask each bit and apply the 1 or 0 to the assigned pin.  All off in RX.
+    for (uint8_t i = 0; i < BAND_DECODE_BITS; i++)
+        if (band_decode_ptt_pins[i] != GPIO_PIN_NOT_USED) digitalWrite(band_decode_ptt_pins[i], PTT_state && (pattern & (1 << i)));
 }
 
 void Decoder_GPIO_Pin_Setup(void)
@@ -2579,25 +2590,12 @@ void Decoder_GPIO_Pin_Setup(void)
     // If using the Teensy SDR motherboard and you have physical switch hardware on any of these then you need to pick alernate pins.
     // Most pins are alrewady goiven a #define bname in RadioCOnfig, substitute the right ones in here.  Make sure they are free.
 
-    // set up our Decoder output pins if enabled
-    if (BAND_DECODE_OUTPUT_PIN_0 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_OUTPUT_PIN_0, OUTPUT);  // bit 0
-    if (BAND_DECODE_OUTPUT_PIN_1 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_OUTPUT_PIN_1, OUTPUT);  // bit 1
-    if (BAND_DECODE_OUTPUT_PIN_2 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_OUTPUT_PIN_2, OUTPUT);  // bit 2
-    if (BAND_DECODE_OUTPUT_PIN_3 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_OUTPUT_PIN_3, OUTPUT);  // bit 3
-    if (BAND_DECODE_OUTPUT_PIN_4 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_OUTPUT_PIN_4, OUTPUT);  // bit 4
-    if (BAND_DECODE_OUTPUT_PIN_5 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_OUTPUT_PIN_5, OUTPUT);  // bit 5
-    if (BAND_DECODE_OUTPUT_PIN_6 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_OUTPUT_PIN_6, OUTPUT);  // bit 6
-    if (BAND_DECODE_OUTPUT_PIN_7 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_OUTPUT_PIN_7, OUTPUT);  // bit 7
-    
-    // set up our PTT breakout pins if enabled
-    if (BAND_DECODE_PTT_OUTPUT_PIN_0 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_PTT_OUTPUT_PIN_0, OUTPUT);  // bit 0
-    if (BAND_DECODE_PTT_OUTPUT_PIN_1 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_PTT_OUTPUT_PIN_1, OUTPUT);  // bit 1
-    if (BAND_DECODE_PTT_OUTPUT_PIN_2 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_PTT_OUTPUT_PIN_2, OUTPUT);  // bit 2
-    if (BAND_DECODE_PTT_OUTPUT_PIN_3 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_PTT_OUTPUT_PIN_3, OUTPUT);  // bit 3
-    if (BAND_DECODE_PTT_OUTPUT_PIN_4 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_PTT_OUTPUT_PIN_4, OUTPUT);  // bit 4
-    if (BAND_DECODE_PTT_OUTPUT_PIN_5 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_PTT_OUTPUT_PIN_5, OUTPUT);  // bit 5
-    if (BAND_DECODE_PTT_OUTPUT_PIN_6 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_PTT_OUTPUT_PIN_6, OUTPUT);  // bit 6
-    if (BAND_DECODE_PTT_OUTPUT_PIN_7 != GPIO_PIN_NOT_USED) pinMode(BAND_DECODE_PTT_OUTPUT_PIN_7, OUTPUT);  // bit 7
+    // set up our Decoder output pins and PTT breakout pins if enabled
+    for (uint8_t i = 0; i < BAND_DECODE_BITS; i++)
+    {
+        if (band_decode_pins[i]     != GPIO_PIN_NOT_USED) pinMode(band_decode_pins[i], OUTPUT);
+        if (band_decode_ptt_pins[i] != GPIO_PIN_NOT_USED) pinMode(band_decode_ptt_pins[i], OUTPUT);
+    }
      
     DPRINTLNF("Decoder_GPIO_Pin_Setup: Pin Mode Setup complete");
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -19,6 +19,7 @@ void Mute();
 void Menu();
 void Display();
 void Band(uint8_t new_band);
+void Band_Select(uint8_t new_band);
 void BandDn();
 void BandUp();
 void Notch();
@@ -27,11 +28,13 @@ void Enet();
 void setNR();
 void setNB(int8_t toggle);
 void Xmit(uint8_t state);
+void Radio_State_Changed(uint8_t field, int64_t value);
 void Ant();
 void Fine();
 void Rate(int8_t dir);
 void setMode(int8_t dir);
 void AGC(int8_t dir);
+bool AGC_Fast_Only(uint8_t mndx);
 void Filter(int8_t dir);
 void ATU(uint8_t state);
 void Split(uint8_t state);
@@ -57,7 +60,6 @@ void Zoom(int8_t dir);
 void setZoom(int8_t toggle);
 void setPAN(int8_t toggle);
 void PAN(int8_t delta);
-void digital_step_attenuator_PE4305(int16_t _attn);   // Takes a 0 to 100 input, converts to the appropriate hardware steps such as 0-31dB in 1 dB steps
 uint64_t find_new_band(uint64_t new_frequency, uint8_t &_curr_band);
 void clearMeter(void);
 void send_Mode_to_Radio(uint8_t mndx);
@@ -88,5 +90,7 @@ void GPIO_Out(uint8_t pattern);
 void Decoder_GPIO_Pin_Setup(void);
 void GPIO_PTT_Out(uint8_t pattern, uint8_t PTT_state);
 void PTT_Output(uint8_t band, uint8_t PTT_state);
+uint8_t GPIO_Out_Get(void);     // last band decode pattern driven
+uint8_t PTT_Output_Get(void);   // last PTT state driven, after the holds
 
 #endif  // _CONTROLS_H_
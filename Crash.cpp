@@ -0,0 +1,153 @@
+//
+//  Crash.cpp
+//
+//  The Teensy core copies the vector table to RAM, the fault entries are pointed at Crash_Fault_Handler() here.
+//  The handler works out which stack the exception frame went to and passes it to Crash_Capture().
+//  The record is in DMAMEM like the watchdog record and the flight recorder, the startup code does not clear it.
+//  Faults before Crash_Init() still go to the core handler and show up in CrashReport.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Watchdog.h"
+#include "Event_Log.h"
+#include "Crash.h"
+#include "SD.h"
+#include "No_Heap.h"
+
+#ifdef USE_RA8875
+    extern RA8875 tft;
+#else
+    extern RA8876_t3 tft;
+#endif
+extern bool sdSetup;
+
+#define CRASH_MAGIC         0x43525348      // "CRSH"
+#define CRASH_FILE          "crash.log"
+#define CRASH_SPLASH_MS     3000            // time to read the splash screen note
+
+DMAMEM static struct Crash_Record crash;    // not cleared on reset
+
+static const char * Crash_Name(uint16_t exception)
+{
+    switch (exception)
+    {
+        case 3:  return "HardFault";
+        case 4:  return "MemManage";
+        case 5:  return "BusFault";
+        case 6:  return "UsageFault";
+        default: return "Exception";
+    }
+}
+
+// Called from the handler below with the exception frame.  No debug prints, the outputs go safe first.
+extern "C" void Crash_Capture(uint32_t *frame, uint32_t exc_return) __attribute__((used));
+extern "C" void Crash_Capture(uint32_t *frame, uint32_t exc_return)
+{
+    uint32_t ipsr;
+
+    Watchdog_Safe_State();
+
+    __asm__ volatile("mrs %0, ipsr" : "=r" (ipsr));
+    if (crash.magic != CRASH_MAGIC)
+    {
+        crash.magic = CRASH_MAGIC;
+        crash.count = 0;
+    }
+    crash.count++;
+    crash.valid      = 1;
+    crash.stage      = Watchdog_Stage_Now();
+    crash.exception  = ipsr & 0x1FF;
+    crash.uptime_ms  = millis();
+    crash.r0         = frame[0];
+    crash.r1         = frame[1];
+    crash.r2         = frame[2];
+    crash.r3         = frame[3];
+    crash.r12        = frame[4];
+    crash.lr         = frame[5];
+    crash.pc         = frame[6];
+    crash.xpsr       = frame[7];
+    crash.sp         = (uint32_t) frame + ((exc_return & 0x10) ? 32 : 104);    // basic or FPU extended frame
+    crash.exc_return = exc_return;
+    crash.cfsr       = SCB_CFSR;
+    crash.hfsr       = SCB_HFSR;
+    crash.mmfar      = SCB_MMFAR;
+    crash.bfar       = SCB_BFAR;
+    crash.event_count = Event_Log_Latest(crash.events, CRASH_EVENTS);
+    arm_dcache_flush(&crash, sizeof(crash));
+
+    SCB_AIRCR = 0x05FA0004;     // system reset
+    while (1) ;
+}
+
+// EXC_RETURN bit 2 says which stack pointer holds the frame
+__attribute__((naked)) static void Crash_Fault_Handler(void)
+{
+    __asm__ volatile(
+        "tst    lr, #4          \n"
+        "ite    eq              \n"
+        "mrseq  r0, msp         \n"
+        "mrsne  r0, psp         \n"
+        "mov    r1, lr          \n"
+        "b      Crash_Capture   \n");
+}
+
+COLD void Crash_Init(void)
+{
+    _VectorsRam[3] = Crash_Fault_Handler;   // HardFault
+    _VectorsRam[4] = Crash_Fault_Handler;   // MemManage
+    _VectorsRam[5] = Crash_Fault_Handler;   // BusFault
+    _VectorsRam[6] = Crash_Fault_Handler;   // UsageFault
+    __asm__ volatile("dsb; isb");
+}
+
+static void Crash_Print(Print &out)
+{
+    out.printf("Crash %lu: %s at %lums uptime, loop stage %s\n", crash.count, Crash_Name(crash.exception), crash.uptime_ms, Watchdog_Stage_Name(crash.stage));
+    out.printf("  PC 0x%08lX  LR 0x%08lX  SP 0x%08lX  xPSR 0x%08lX  EXC_RETURN 0x%08lX\n", crash.pc, crash.lr, crash.sp, crash.xpsr, crash.exc_return);
+    out.printf("  R0 0x%08lX  R1 0x%08lX  R2 0x%08lX  R3 0x%08lX  R12 0x%08lX\n", crash.r0, crash.r1, crash.r2, crash.r3, crash.r12);
+    out.printf("  CFSR 0x%08lX  HFSR 0x%08lX  MMFAR 0x%08lX  BFAR 0x%08lX\n", crash.cfsr, crash.hfsr, crash.mmfar, crash.bfar);
+    for (uint8_t i = 0; i < crash.event_count && i < CRASH_EVENTS; i++)
+        out.printf("  Event %10lums %-10s %3u %5u\n", crash.events[i].ms, Event_Log_Name(crash.events[i].type), crash.events[i].a, crash.events[i].b);
+}
+
+COLD void Crash_Report(void)
+{
+    File f;
+    char line[64];
+
+    if (crash.magic != CRASH_MAGIC || !crash.valid)
+        return;
+
+    Crash_Print(PC_Debug_port);
+    if (sdSetup)
+    {
+        f = SD.open(CRASH_FILE, FILE_WRITE);    // appends
+        if (f)
+        {
+            Crash_Print(f);
+            f.close();
+        }
+    }
+    Event_Log_Record(EVT_CRASH, crash.exception, crash.count);
+
+    snprintf(line, sizeof(line), "Restarted after %s at PC 0x%08lX", Crash_Name(crash.exception), crash.pc);
+    tft.setFont(Arial_14);
+    tft.setTextColor(RED);
+    tft.setCursor(70, 350);
+    tft.print(line);
+    snprintf(line, sizeof(line), "Loop stage %s.  Details in " CRASH_FILE, Watchdog_Stage_Name(crash.stage));
+    tft.setCursor(70, 375);
+    tft.print(line);
+    delay(CRASH_SPLASH_MS);
+
+    crash.valid = 0;
+    arm_dcache_flush(&crash, sizeof(crash));
+}
+
+// Test hook.  An undefined instruction raises a UsageFault, the unit should restart and report it.
+COLD void Crash_Inject(void)
+{
+    DPRINTLNF("Crash_Inject: Undefined instruction");
+    __asm__ volatile("udf #0");
+}
@@ -0,0 +1,38 @@
+#ifndef _CRASH_H_
+#define _CRASH_H_
+//
+//  Crash.h
+//
+//  Fault capture.  HardFault, MemManage, BusFault and UsageFault drop the outputs to RX, save the faulting registers,
+//  the loop() stage that was running and the last few flight recorder events in RAM that survives the reset, and
+//  restart.  On the next boot the record goes to the splash screen, the Debug port and crash.log on the SD card.
+//  PythonApps/crash_symbolize.py turns the addresses back into function names with the build's ELF file.
+//
+#include <Arduino.h>
+#include "Event_Log.h"
+
+#define CRASH_EVENTS        4       // flight recorder entries kept with the record
+
+struct Crash_Record {
+    uint32_t magic;
+    uint32_t count;         // crashes since power up
+    uint8_t  valid;         // not yet reported
+    uint8_t  stage;         // Watchdog_Stage running at the fault
+    uint16_t exception;     // IPSR, 3 HardFault, 4 MemManage, 5 BusFault, 6 UsageFault
+    uint32_t uptime_ms;
+    uint32_t r0, r1, r2, r3, r12;
+    uint32_t lr;            // stacked LR, the caller of the faulting function
+    uint32_t pc;            // stacked PC, the faulting instruction
+    uint32_t xpsr;
+    uint32_t sp;            // stack pointer before the exception
+    uint32_t exc_return;
+    uint32_t cfsr, hfsr, mmfar, bfar;
+    struct Event_Entry events[CRASH_EVENTS];
+    uint8_t  event_count;
+};
+
+void Crash_Init(void);      // early in setup(), installs the fault handlers
+void Crash_Report(void);    // after the SD card is up and while the splash screen shows.  Reports and clears the record
+void Crash_Inject(void);    // test: take a fault through the handlers
+
+#endif // _CRASH_H_
@@ -4,6 +4,7 @@
 #include "CIV-USB-Band-Decoder.h"
 #include "RadioConfig.h"
 #include "Display.h"
+#include "Freq_Codec.h"
       
 #ifdef USE_RA8875
 	extern RA8875 tft;
@@ -91,8 +92,9 @@ uint8_t _colorIndex = 0;
 	//inline void 	Color565ToRGB(uint16_t color, uint8_t &r, uint8_t &g, uint8_t &b){r = (((color & 0xF800) >> 11) * 527 + 23) >> 6; g = (((color & 0x07E0) >> 5) * 259 + 33) >> 6; b = ((color & 0x001F) * 527 + 23) >> 6;}
 //----------------------------------------------------------------------------------------------
 
-COLD void displayFreq(void)
+PLACE(displayFreq) void displayFreq(void)
 {
+	PROF(displayFreq);
 	static uint64_t vfo_b_last  = 0;
 	static uint8_t 	xmit_last   = 0;
 	static uint8_t 	xit_last    = 0;
@@ -612,8 +614,9 @@ COLD void displayTime(void)
 }
 
 // val = bar graph value (0 to 10 range), string is the meter text, color set
-COLD void displayMeter(int val, const char *string, uint16_t colorscheme)
+PLACE(displayMeter) void displayMeter(int val, const char *string, uint16_t colorscheme)
 {
+	PROF(displayMeter);
 	if (popup) return;  // Do not write to the screen when a window is active
 
 	draw_2_state_Button(SMETER_BTN, &std_btn[SMETER_BTN].show);  // clear out text remnants if any
@@ -734,8 +737,9 @@ COLD void displayDATA()
 //  Notes:  Default is to handle 2 states today. However, the control function can change the buttom text
 //			and set a value in the button's enabled field to track states.
 //
-COLD void draw_2_state_Button(uint8_t button, uint8_t *function_ptr) 
+PLACE(draw_2_state_Button) void draw_2_state_Button(uint8_t button, uint8_t *function_ptr) 
 {
+    PROF(draw_2_state_Button);
     struct Standard_Button *ptr = std_btn + button;     // pointer to button object passed by calling function
 	
 	if(ptr->show)
@@ -764,8 +768,9 @@ COLD void draw_2_state_Button(uint8_t button, uint8_t *function_ptr)
 	}
 }
 
-COLD void drawLabel(uint8_t lbl_num, uint8_t *function_ptr)
+PLACE(drawLabel) void drawLabel(uint8_t lbl_num, uint8_t *function_ptr)
 {
+	PROF(drawLabel);
 	struct Label *plabel = labels + lbl_num;
 
 	if (plabel->show)
@@ -806,18 +811,14 @@ COLD void drawLabel(uint8_t lbl_num, uint8_t *function_ptr)
 //
 //    formatVFO()
 //
-COLD const char* formatVFO(uint64_t vfo)
+PLACE(formatVFO) const char* formatVFO(uint64_t vfo)
 {
-	static char vfo_str[20] = {""};
+	PROF(formatVFO);
+	static char vfo_str[FREQ_TEXT_MAX] = {""};
 	if (ModeOffset < -1 || ModeOffset > 1)
 		vfo += ModeOffset;  // Account for pitch offset when in CW mode, not others
 	
-	uint32_t MHz = (vfo/1000000 % 1000000);
-	uint16_t Hz  = (vfo % 1000);
-	uint16_t KHz = ((vfo % 1000000) - Hz)/1000;
-	sprintf(vfo_str, "%lu.%03u.%03u", MHz, KHz, Hz);
-	
-	///sprintf(vfo_str, "%-13s", "012345.123.123");  // 999GHZ max  47G = 47000.000.000
+	Freq_To_Text(vfo, vfo_str, FREQ_SEP_KHZ, FREQ_SEP_HZ, FREQ_RESOLUTION);  // 999GHZ max  47G = 47000.000.000
 	///DPRINT("New VFO: ");DPRINTLN(vfo_str);
 	return vfo_str;
 }
@@ -0,0 +1,157 @@
+//
+//  Drive_Limit.cpp
+//
+//  Per band transmit drive limit with a read back interlock.
+//  On band entry the radio's RF power is clamped to bandmem[].drive_limit and read back.  PTT_Output() keeps the band
+//  decode PTT outputs in RX until the read back shows the radio at or below the limit.
+//  After that the RF power is read every DRIVE_POLL_MS, the radio does not report front panel or PC level changes.
+//  A level above the limit raises the alarm on the XVTR label, drops the PTT outputs and clamps the radio again.
+//  Reads use the same send-then-listen pattern as Hydrate_Service(), the reply comes in through the radio state model.
+//  With NO_SEND 1 the level can be neither set nor read, so the limits are skipped and the PTT outputs are not held.
+//  Band entry says so on the Debug port for a band that has a limit.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Controls.h"
+#include "Display.h"
+#include "Hydrate.h"
+#include "Radio_State.h"
+#include "Drive_Limit.h"
+#include "Radio_Model.h"
+#include "No_Heap.h"
+
+extern CIV civ;
+extern struct cmdList cmd_List[];
+extern struct Band_Memory bandmem[];
+extern struct Label labels[];
+extern uint8_t Check_radio(void);
+
+static uint8_t  drv_state   = DRIVE_OFF;
+static uint8_t  drv_band    = 0;
+static uint32_t drv_poll    = 0;        // millis() of the last read request
+static bool     drv_waiting = false;
+static bool     drv_ptt     = false;    // PTT_Output() was asked for TX
+
+static void Drive_Limit_Alert(bool alarm)
+{
+    strcpy(labels[XVTR_LBL].label, alarm ? "DRV" : "XVTR");
+    displayXVTR();
+}
+
+static void Drive_Limit_Clamp(uint8_t band)
+{
+    uint8_t limit = bandmem[band].drive_limit;
+    uint8_t data_str[3] = {2, bcdByteEncode(limit / 100), bcdByteEncode(limit % 100)};
+
+    civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RFPOWER].cmdData), data_str, CIV_wFast);
+    RS_Request(RS_RF_POWER, limit);     // stays pending until the read back
+    DPRINTF("Drive_Limit_Clamp: RF power set to "); DPRINT(limit); DPRINTF(" on "); DPRINTLN(bandmem[band].band_name);
+}
+
+static void Drive_Limit_Read(uint32_t now)
+{
+    civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_RFPOWER].cmdData), CIV_D_NIX, CIV_wFast);
+    drv_poll    = now;
+    drv_waiting = true;
+}
+
+COLD void Drive_Limit_Band(uint8_t band)
+{
+    if (band >= BANDS)
+        return;
+
+    drv_band    = band;
+    drv_waiting = false;
+    if (drv_state == DRIVE_ALARM)
+        Drive_Limit_Alert(false);
+
+    if (bandmem[band].drive_limit == 255)
+    {
+        drv_state = DRIVE_OFF;
+        return;
+    }
+    if (NO_SEND)
+    {
+        drv_state = DRIVE_OFF;
+        DPRINTF("Drive_Limit_Band: Limit on "); DPRINT(bandmem[band].band_name); DPRINTLNF(" not enforced, NO_SEND 1 blocks the RF power set and read back");
+        return;
+    }
+
+    drv_state = DRIVE_UNVERIFIED;
+    if (!(RS_Source(RS_RF_POWER) == RS_SRC_RADIO && RS_Get(RS_RF_POWER) <= bandmem[band].drive_limit))
+        Drive_Limit_Clamp(band);
+    Drive_Limit_Read(millis());
+}
+
+// A read back arrived.  Confirm, or alarm and clamp again.
+static void Drive_Limit_Check(int64_t pwr)
+{
+    uint8_t limit = bandmem[drv_band].drive_limit;
+
+    if (pwr <= limit)
+    {
+        if (drv_state == DRIVE_OK)
+            return;
+        if (drv_state == DRIVE_ALARM)
+            Drive_Limit_Alert(false);
+        drv_state = DRIVE_OK;
+        DPRINTF("Drive_Limit_Check: RF power "); DPRINT((int32_t) pwr); DPRINTF(" confirmed, limit "); DPRINTLN(limit);
+        if (drv_ptt)
+            PTT_Output(drv_band, 1);    // TX was asked for while held
+        return;
+    }
+
+    DPRINTF("Drive_Limit_Check: RF power "); DPRINT((int32_t) pwr); DPRINTF(" above limit "); DPRINT(limit); DPRINTLNF(", clamping");
+    if (drv_state != DRIVE_ALARM)
+        Drive_Limit_Alert(true);
+    drv_state = DRIVE_ALARM;
+    if (drv_ptt)
+        PTT_Output(drv_band, 1);        // held in RX now
+    Drive_Limit_Clamp(drv_band);
+}
+
+PLACE(Drive_Limit_Service) void Drive_Limit_Service(void)
+{
+    PROF(Drive_Limit_Service);
+    uint32_t now;
+
+    if (drv_state == DRIVE_OFF || Hydrate_Busy())
+        return;
+
+    now = millis();
+    if (!drv_waiting)
+    {
+        if ((now - drv_poll) >= (drv_state == DRIVE_OK ? DRIVE_POLL_MS : DRIVE_RETRY_MS))
+            Drive_Limit_Read(now);
+        return;
+    }
+
+    Check_radio();
+    if (RS_Source(RS_RF_POWER) == RS_SRC_RADIO && RS_Age(RS_RF_POWER) <= (now - drv_poll))
+    {
+        drv_waiting = false;
+        Drive_Limit_Check(RS_Get(RS_RF_POWER));
+    }
+    else if ((now - drv_poll) >= HYDRATE_REPLY_MS)
+        drv_waiting = false;    // ask again after DRIVE_RETRY_MS
+}
+
+bool Drive_Limit_PTT_OK(uint8_t band)
+{
+    if (NO_SEND || band >= BANDS || bandmem[band].drive_limit == 255)
+        return true;
+    return band == drv_band && drv_state == DRIVE_OK;
+}
+
+void Drive_Limit_PTT(uint8_t band, uint8_t state)
+{
+    if (band == drv_band)
+        drv_ptt = state;
+}
+
+uint8_t Drive_Limit_State(void)
+{
+    return drv_state;
+}
@@ -0,0 +1,24 @@
+#ifndef _DRIVE_LIMIT_H_
+#define _DRIVE_LIMIT_H_
+//
+//  Drive_Limit.h
+//
+//  Per band transmit drive limit.  Keeps the IF radio's RF power at or below bandmem[].drive_limit so a transverter
+//  input is not overdriven, and holds the band decode PTT outputs in RX until the radio's setting is read back.
+//
+#include <Arduino.h>
+
+enum Drive_State {
+    DRIVE_OFF,              // no limit on this band, or NO_SEND 1
+    DRIVE_UNVERIFIED,       // limit pushed, waiting for the read back.  PTT_Output() held in RX
+    DRIVE_OK,               // radio read back at or below the limit
+    DRIVE_ALARM             // radio went above the limit, clamped again and waiting for the read back
+};
+
+void Drive_Limit_Band(uint8_t band);                // band entry, push the limit and start the read back
+void Drive_Limit_Service(void);                     // call every loop pass.  Read back and the front panel/PC watch
+bool Drive_Limit_PTT_OK(uint8_t band);              // false while PTT outputs must stay in RX
+void Drive_Limit_PTT(uint8_t band, uint8_t state);  // PTT_Output() reports what it was asked for
+uint8_t Drive_Limit_State(void);
+
+#endif // _DRIVE_LIMIT_H_
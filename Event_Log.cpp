@@ -0,0 +1,199 @@
+//
+//  Event_Log.cpp
+//
+//  The ring lives in DMAMEM (RAM2) like the watchdog record, the startup code does not clear it.  Each entry is pushed
+//  out of the data cache as it is written so it is there after any reset, not only the ones we see coming.
+//  Event_Log_Record() is a handful of stores with interrupts held off, it is called after the pins are driven so the
+//  output timing does not change.  The cost of every call is measured with the cycle counter, see Event_Log_Get_Stats().
+//  The SD card copy is plain text, one line per event, appended only while no TX source is keyed.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Display.h"
+#include "TX_Timer.h"
+#include "Event_Log.h"
+#include "Mem_Stats.h"
+#include "SD.h"
+#include "No_Heap.h"
+
+#ifdef USE_RA8875
+    extern RA8875 tft;
+#else
+    extern RA8876_t3 tft;
+#endif
+extern struct Standard_Button std_btn[];
+extern bool sdSetup;
+
+#define EV_RING_MAGIC       0x45564C47      // "EVLG"
+#define EV_FILE             "events.log"
+
+struct Event_Ring {
+    uint32_t magic;
+    uint32_t boots;         // since the ring was last initialized
+    uint32_t head;          // sequence number of the next entry
+    uint32_t flushed;       // sequence number of the next entry to write to the SD card
+    struct Event_Entry entry[EVENT_LOG_SIZE];
+};
+
+DMAMEM static struct Event_Ring ev_ring;            // not cleared on reset
+
+static const char * const ev_names[EVT_TYPES] = {"BOOT", "BAND", "PTT", "XMIT", "LINK", "INTERLOCK", "WATCHDOG", "TX_TIMEOUT", "CRASH", "MEM"};
+
+static struct Event_Log_Stats ev_stats;
+static uint32_t ev_flush     = 0;       // millis() of the last SD card write
+static bool     ev_showing   = false;   // our popup window is up
+
+COLD void Event_Log_Init(void)
+{
+    if (ev_ring.magic != EV_RING_MAGIC || (ev_ring.head - ev_ring.flushed) > ev_ring.head)
+    {
+        memset(&ev_ring, 0, sizeof(ev_ring));
+        ev_ring.magic = EV_RING_MAGIC;
+    }
+    ev_ring.boots++;
+    arm_dcache_flush(&ev_ring, sizeof(ev_ring) - sizeof(ev_ring.entry));
+    Event_Log_Record(EVT_BOOT, ev_ring.boots, SRC_SRSR);
+    DPRINTF("Event_Log_Init: Boot "); DPRINT(ev_ring.boots); DPRINTF("  "); DPRINT(ev_ring.head - ev_ring.flushed); DPRINTLNF(" events not yet on the SD card");
+}
+
+HOT void Event_Log_Record(uint8_t type, uint8_t a, uint16_t b)
+{
+    uint32_t start = ARM_DWT_CYCCNT;
+    uint32_t primask;
+    struct Event_Entry *e;
+
+    __asm__ volatile("mrs %0, primask" : "=r" (primask));   // may already be in an interrupt
+    __disable_irq();
+    e = &ev_ring.entry[ev_ring.head % EVENT_LOG_SIZE];
+    e->ms   = millis();
+    e->type = type;
+    e->a    = a;
+    e->b    = b;
+    ev_ring.head++;
+    if (!primask)
+        __enable_irq();
+
+    arm_dcache_flush(e, sizeof(*e));
+    arm_dcache_flush(&ev_ring.head, sizeof(ev_ring.head));
+    ev_stats.recorded++;
+    if ((ARM_DWT_CYCCNT - start) > ev_stats.max_cycles)
+        ev_stats.max_cycles = ARM_DWT_CYCCNT - start;
+}
+
+const char * Event_Log_Name(uint8_t type)
+{
+    return type < EVT_TYPES ? ev_names[type] : "?";
+}
+
+static void Event_Log_Print(Print &out, uint32_t seq)
+{
+    const struct Event_Entry *e = &ev_ring.entry[seq % EVENT_LOG_SIZE];
+
+    out.printf("%6lu %10lums %-10s %3u %5u\n", seq, e->ms, Event_Log_Name(e->type), e->a, e->b);
+}
+
+// Oldest entry still in the ring
+static uint32_t Event_Log_First(void)
+{
+    return ev_ring.head > EVENT_LOG_SIZE ? ev_ring.head - EVENT_LOG_SIZE : 0;
+}
+
+static void Event_Log_Flush(void)
+{
+    File f = SD.open(EV_FILE, FILE_WRITE);  // appends
+
+    if (!f)
+    {
+        DPRINTLNF("Event_Log_Flush: error opening " EV_FILE);
+        return;
+    }
+    if (ev_ring.flushed < Event_Log_First())
+    {
+        f.printf("# %lu events lost, ring overrun\n", Event_Log_First() - ev_ring.flushed);
+        ev_ring.flushed = Event_Log_First();
+    }
+    while (ev_ring.flushed != ev_ring.head)
+    {
+        Event_Log_Print(f, ev_ring.flushed++);
+        ev_stats.flushed++;
+    }
+    f.close();
+    arm_dcache_flush(&ev_ring.flushed, sizeof(ev_ring.flushed));
+}
+
+PLACE(Event_Log_Service) void Event_Log_Service(void)
+{
+    PROF(Event_Log_Service);
+    uint32_t now = millis();
+
+    if (sdSetup && ev_ring.flushed != ev_ring.head && (now - ev_flush) >= EVENT_LOG_FLUSH_MS && !TX_Timer_Keyed())
+    {
+        ev_flush = now;
+        Event_Log_Flush();
+    }
+}
+
+// Plain copies, no locking.  Also used from the fault handler.
+uint8_t Event_Log_Latest(struct Event_Entry *out, uint8_t count)
+{
+    uint32_t seq = ev_ring.head - count;
+
+    if (count > ev_ring.head - Event_Log_First())
+    {
+        count = ev_ring.head - Event_Log_First();
+        seq   = Event_Log_First();
+    }
+    for (uint8_t i = 0; i < count; i++)
+        out[i] = ev_ring.entry[(seq + i) % EVENT_LOG_SIZE];
+    return count;
+}
+
+COLD void Event_Log_Dump(void)
+{
+    PC_Debug_port.printf("Event_Log_Dump: Boot %lu, %lu recorded this boot, longest record %lu cycles\n", ev_ring.boots, ev_stats.recorded, ev_stats.max_cycles);
+    for (uint32_t seq = Event_Log_First(); seq != ev_ring.head; seq++)
+        Event_Log_Print(PC_Debug_port, seq);
+}
+
+COLD void Event_Log_Show(void)
+{
+    struct Standard_Button *ptr = &std_btn[SPECTUNE_BTN];
+    uint16_t y;
+    uint16_t lines;
+    uint32_t seq;
+
+    pop_win_up(SPECTUNE_BTN);
+    ev_showing = true;
+    tft.setFont(Arial_14);
+    tft.setTextColor(WHITE);
+    y     = Mem_Show(ptr->bx + 10, ptr->by + 5);
+    lines = (ptr->by + ptr->bh - y) / 22;
+    seq   = ev_ring.head > lines ? ev_ring.head - lines : 0;
+    if (seq < Event_Log_First())
+        seq = Event_Log_First();
+
+    for ( ; seq != ev_ring.head; seq++, y += 22)
+    {
+        const struct Event_Entry *e = &ev_ring.entry[seq % EVENT_LOG_SIZE];
+        char line[48];
+
+        snprintf(line, sizeof(line), "%10lums  %-10s %3u %5u", e->ms, Event_Log_Name(e->type), e->a, e->b);
+        tft.setCursor(ptr->bx + 10, y);
+        tft.print(line);
+    }
+}
+
+bool Event_Log_Hide(void)
+{
+    if (!ev_showing)
+        return false;
+    ev_showing = false;
+    pop_win_down(SPECTUNE_BTN);
+    return true;
+}
+
+const struct Event_Log_Stats * Event_Log_Get_Stats(void)
+{
+    return &ev_stats;
+}
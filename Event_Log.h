@@ -0,0 +1,51 @@
+#ifndef _EVENT_LOG_H_
+#define _EVENT_LOG_H_
+//
+//  Event_Log.h
+//
+//  Flight recorder.  Band decode changes, PTT transitions, CI-V link loss, interlock trips and watchdog faults are
+//  time stamped into a ring in RAM that survives a warm reset.  New entries are appended to events.log on the SD card
+//  every EVENT_LOG_FLUSH_MS.  Read back with a long press on the Menu button or EVENT_LOG_DUMP_KEY on the Debug port.
+//
+#include <Arduino.h>
+
+#define EVENT_LOG_SIZE      256     // entries, 8 bytes each in RAM2
+
+enum Event_Type {
+    EVT_BOOT,               // a = boot count, b = SRC_SRSR reset cause bits
+    EVT_BAND,               // a = band, b = band decode pattern
+    EVT_PTT,                // a = band decode PTT state, b = band
+    EVT_XMIT,               // a = PTT_OUT1 state, 1 = TX
+    EVT_LINK,               // a = 1 radio answering again, 0 lost.  b = seconds since the last reply.  See Link.cpp
+    EVT_INTERLOCK,          // a = input, b = fault to RX time in us
+    EVT_WATCHDOG,           // a = stages that had not checked in
+    EVT_TX_TIMEOUT,         // a = band, b = limit in seconds
+    EVT_CRASH,              // logged on the boot after a fault.  a = exception number, b = crashes since power up
+    EVT_MEM,                // new high-water mark.  a = 0 stack, 1 heap.  b = KB used
+    EVT_TYPES
+};
+
+struct Event_Entry {
+    uint32_t ms;            // millis() since that boot
+    uint8_t  type;          // Event_Type
+    uint8_t  a;
+    uint16_t b;
+};
+
+struct Event_Log_Stats {
+    uint32_t recorded;      // this boot
+    uint32_t flushed;       // written to the SD card this boot
+    uint32_t max_cycles;    // longest Event_Log_Record() call in CPU cycles
+};
+
+void Event_Log_Init(void);                                  // first thing in setup().  Keeps the ring from before the reset
+void Event_Log_Record(uint8_t type, uint8_t a, uint16_t b); // safe from interrupts
+void Event_Log_Service(void);                               // call every loop pass.  SD flush
+uint8_t Event_Log_Latest(struct Event_Entry *out, uint8_t count);  // copy the newest entries, oldest first
+const char * Event_Log_Name(uint8_t type);
+void Event_Log_Dump(void);                                  // every entry still in the ring to the Debug port
+void Event_Log_Show(void);                                  // diagnostics popup, memory summary and the latest entries
+bool Event_Log_Hide(void);                                  // popup timeout.  true if the window was ours
+const struct Event_Log_Stats * Event_Log_Get_Stats(void);
+
+#endif // _EVENT_LOG_H_
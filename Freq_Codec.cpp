@@ -0,0 +1,211 @@
+//
+//  Freq_Codec.cpp
+//
+//  The Teensy 4 has no 64 bit divide instruction, a uint64_t / or % is a library call of a few hundred cycles and the
+//  old BCD and text paths made a dozen of them per frequency.  Here the frequency is split once into the parts above
+//  and below 10^8 Hz and the digits come from 32 bit divides by constants, which the compiler turns into multiplies.
+//  Frequencies below 4.29 GHz split with one of those, higher ones with a 14 step shift and subtract.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Vfo.h"
+#include "Freq_Codec.h"
+#include "No_Heap.h"
+
+extern struct Band_Memory bandmem[];
+
+#define FREQ_SPLIT          100000000UL     // 10^8, the low part holds 8 digits, 4 BCD bytes
+
+static const uint16_t freq_pow10[4] = {1, 10, 100, 1000};
+
+// hz / 10^8, the remainder goes in lo
+static uint32_t Freq_Split(uint64_t hz, uint32_t *lo)
+{
+    uint32_t hi = 0;
+
+    if (hz > FREQ_MAX_HZ)
+        hz = FREQ_MAX_HZ;
+    if ((hz >> 32) == 0)
+    {
+        hi  = (uint32_t) hz / FREQ_SPLIT;
+        *lo = (uint32_t) hz - hi * FREQ_SPLIT;
+        return hi;
+    }
+    for (int8_t k = 13; k >= 0; k--)    // hi < 10^4 < 2^14
+    {
+        uint64_t d = (uint64_t) FREQ_SPLIT << k;
+
+        if (hz >= d)
+        {
+            hz -= d;
+            hi |= 1UL << k;
+        }
+    }
+    *lo = (uint32_t) hz;
+    return hi;
+}
+
+// 0x00 0x50 0x04 0x44 0x01 = 144,045,000 Hz
+HOT uint8_t Freq_To_BCD(uint64_t hz, uint8_t *bcd)
+{
+    uint32_t lo, q;
+    uint32_t hi = Freq_Split(hz, &lo);
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        q      = lo / 100;
+        bcd[i] = bcdByteEncode(lo - q * 100);
+        lo     = q;
+    }
+    bcd[4] = bcdByteEncode(hi % 100);
+    if (hz < FREQ_BCD_6_HZ)
+        return 5;
+    bcd[5] = bcdByteEncode(hi / 100);
+    return 6;
+}
+
+HOT uint64_t Freq_From_BCD(const uint8_t *bcd, uint8_t len)
+{
+    uint32_t lo = 0, hi = 0;
+
+    if (len > FREQ_BCD_MAX)
+        len = FREQ_BCD_MAX;
+    for (int8_t i = len - 1; i >= 4; i--)
+        hi = hi * 100 + bcdByte(bcd[i]);
+    for (int8_t i = (len < 4 ? len : 4) - 1; i >= 0; i--)
+        lo = lo * 100 + bcdByte(bcd[i]);
+    return (uint64_t) hi * FREQ_SPLIT + lo;
+}
+
+// Digits of v, least significant first.  width 0 = as many as needed
+static uint8_t Freq_Digits(char *p, uint32_t v, uint8_t width)
+{
+    uint8_t  n = 0;
+    uint32_t q;
+
+    do {
+        q      = v / 10;
+        p[n++] = '0' + (v - q * 10);
+        v      = q;
+    } while (width ? n < width : v != 0);
+    return n;
+}
+
+// Built backwards in a scratch buffer, then copied out in order
+HOT uint8_t Freq_To_Text(uint64_t hz, char *text, char sep_khz, char sep_hz, uint8_t res)
+{
+    char     tmp[FREQ_TEXT_MAX];
+    uint8_t  n = 0;
+    uint32_t lo, below_mhz, mhz, khz;
+    uint32_t hi = Freq_Split(hz, &lo);
+
+    mhz       = lo / 1000000;
+    below_mhz = lo - mhz * 1000000;
+    mhz      += hi * 100;
+    khz       = below_mhz / 1000;
+
+    if (res > 3)
+        res = 3;
+    if (res < 3)
+    {
+        n += Freq_Digits(&tmp[n], (below_mhz - khz * 1000) / freq_pow10[res], 3 - res);
+        if (sep_hz)
+            tmp[n++] = sep_hz;
+    }
+    n += Freq_Digits(&tmp[n], khz, 3);
+    if (sep_khz)
+        tmp[n++] = sep_khz;
+    n += Freq_Digits(&tmp[n], mhz, 0);
+
+    for (uint8_t i = 0; i < n; i++)
+        text[i] = tmp[n - 1 - i];
+    text[n] = '\0';
+    return n;
+}
+
+//
+//  Test hook.  Round trips every band edge, the edges one Hz either side and the 10 GHz and 122 GHz boundaries through
+//  the codec, compares against the 64 bit divide and snprintf way, and times both.
+//
+
+// The way formatFreq() and formatVFO() used to do it
+static uint8_t Freq_Ref_BCD(uint64_t hz, uint8_t *bcd)
+{
+    uint8_t len = hz < FREQ_BCD_6_HZ ? 5 : 6;
+
+    for (uint8_t i = 0; i < len; ++i)
+    {
+        bcd[i] = bcdByteEncode(static_cast<uint8_t>(hz % 100));
+        hz = hz / 100;
+    }
+    return len;
+}
+
+static void Freq_Ref_Text(uint64_t hz, char *text)
+{
+    uint32_t MHz = (hz / 1000000 % 1000000);
+    uint16_t Hz  = (hz % 1000);
+    uint16_t KHz = ((hz % 1000000) - Hz) / 1000;
+
+    snprintf(text, FREQ_TEXT_MAX, "%lu.%03u.%03u", MHz, KHz, Hz);
+}
+
+static uint8_t Freq_Check_One(uint64_t hz)
+{
+    uint8_t bcd[FREQ_BCD_MAX], ref_bcd[FREQ_BCD_MAX], len;
+    char    text[FREQ_TEXT_MAX], ref_text[FREQ_TEXT_MAX];
+
+    if (hz > FREQ_MAX_HZ)      // an unused band's edge minus one
+        return 0;
+    len = Freq_To_BCD(hz, bcd);
+    Freq_To_Text(hz, text, '.', '.', 0);
+    Freq_Ref_Text(hz, ref_text);
+    if (len == Freq_Ref_BCD(hz, ref_bcd) && !memcmp(bcd, ref_bcd, len) && Freq_From_BCD(bcd, len) == hz &&
+        !strcmp(text, ref_text))
+        return 0;
+
+    DPRINTF("Freq_Codec_Check: Mismatch at "); DPRINT(ref_text); DPRINTF(" got "); DPRINTLN(text);
+    return 1;
+}
+
+COLD void Freq_Codec_Check(void)
+{
+    static const uint64_t extra[] = {0, 1, FREQ_BCD_6_HZ - 1, FREQ_BCD_6_HZ, 24192000000ULL, 122250000000ULL, FREQ_MAX_HZ};
+    uint16_t checked = 0, failed = 0;
+    uint32_t t, codec_cyc, ref_cyc;
+    uint8_t  bcd[FREQ_BCD_MAX];
+    char     text[FREQ_TEXT_MAX];
+    volatile uint64_t hz;           // keeps the timing loops from being folded
+
+    for (uint8_t b = 0; b < BANDS; b++)
+    {
+        for (int8_t d = -1; d <= 1; d++)
+        {
+            failed += Freq_Check_One(bandmem[b].edge_lower + d);
+            failed += Freq_Check_One(bandmem[b].edge_upper + d);
+            checked += 2;
+        }
+    }
+    for (uint8_t i = 0; i < sizeof(extra) / sizeof(extra[0]); i++, checked++)
+        failed += Freq_Check_One(extra[i]);
+
+    hz = 1296100000ULL;
+    t = ARM_DWT_CYCCNT;
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        Freq_To_BCD(hz, bcd);
+        Freq_To_Text(hz, text, '.', '.', 0);
+    }
+    codec_cyc = (ARM_DWT_CYCCNT - t) / 1000;
+    t = ARM_DWT_CYCCNT;
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        Freq_Ref_BCD(hz, bcd);
+        Freq_Ref_Text(hz, text);
+    }
+    ref_cyc = (ARM_DWT_CYCCNT - t) / 1000;
+
+    DPRINTF("Freq_Codec_Check: "); DPRINT(checked); DPRINTF(" frequencies, "); DPRINT(failed); DPRINTF(" failed.  BCD and text ");
+    DPRINT(codec_cyc); DPRINTF(" cycles, old way "); DPRINT(ref_cyc); DPRINTLNF(" cycles");
+}
@@ -0,0 +1,23 @@
+#ifndef _FREQ_CODEC_H_
+#define _FREQ_CODEC_H_
+//
+//  Freq_Codec.h
+//
+//  Frequency conversions shared by the CI-V and display code.  CI-V BCD both ways and display text.
+//  No sprintf, no heap and no 64 bit division, and every function works only on the caller's buffer so they can be
+//  used from anywhere.  Good to 999.999999999 GHz, the most 6 BCD bytes hold.
+//
+#include <Arduino.h>
+
+#define FREQ_BCD_MAX        6                   // bytes, 12 digits
+#define FREQ_BCD_6_HZ       10000000000ULL      // 10 GHz and up take the 6th byte
+#define FREQ_MAX_HZ         999999999999ULL     // larger values are clamped to this
+#define FREQ_TEXT_MAX       16                  // "999999.999.999" and the terminator
+
+uint8_t  Freq_To_BCD(uint64_t hz, uint8_t *bcd);                // LSB first as CI-V sends it.  Returns the length, 5 or 6
+uint64_t Freq_From_BCD(const uint8_t *bcd, uint8_t len);        // LSB first, 1 to 6 bytes
+uint8_t  Freq_To_Text(uint64_t hz, char *text, char sep_khz, char sep_hz, uint8_t res); // MHz, kHz and Hz groups.
+                                                                // sep 0 = none.  res = Hz digits dropped, 0-3.  Returns the length
+void Freq_Codec_Check(void);                                    // test: band edge round trips and timing to the Debug port
+
+#endif // _FREQ_CODEC_H_
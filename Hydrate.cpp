@@ -0,0 +1,210 @@
+//
+//  Hydrate.cpp
+//
+//  Background refresh of radio state after boot.
+//  setup() restores the SD snapshot and brings up the display and band decode first, then calls Hydrate_Start().
+//  Hydrate_Service() runs from the main loop and walks the request list one entry at a time.
+//  Each request is sent without waiting, the reply is picked up on later passes through Check_radio().
+//  Another service's Check_radio() may read the reply first, so an entry is confirmed by what the reply left behind:
+//  a radio state model field set by the radio since the send, or check_CIV() calling BStack_Confirm() or
+//  Hydrate_Confirm() for the replies the model does not hold.
+//  No reply within HYDRATE_REPLY_MS gets a retry, after HYDRATE_RETRIES the entry is skipped and left unconfirmed.
+//  With NO_SEND 1 nothing is requested, the SD snapshot stays until the radio reports on its own.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Hydrate.h"
+#include "Radio_State.h"
+#include "Radio_Model.h"
+
+extern CIV civ;
+extern struct cmdList cmd_List[];
+extern struct User_Settings user_settings[];
+extern uint8_t user_Profile;
+extern bool sdSetup;
+extern uint8_t Check_radio(void);
+
+struct BStack_Status bstack_status[BANDS][BSTACK_REGS];
+
+struct Hydrate_Step {
+    uint8_t cmd;            // cmd_List[] index
+    uint8_t band;           // radio band stack band code, BSTACK only
+    uint8_t reg;            // radio band stack register 1-3, BSTACK only
+    uint8_t field;          // Radio_Field the reply sets, RS_FIELDS if it is confirmed by a call from check_CIV()
+};
+
+#define HYDRATE_STEPS_MAX   (4 + RM_BSTACK_MAX * BSTACK_REGS)
+
+static struct Hydrate_Step hydrate_list[HYDRATE_STEPS_MAX];
+static uint8_t  hydrate_count   = 0;    // entries in hydrate_list
+static uint8_t  hydrate_idx     = 0;    // current entry
+static uint8_t  hydrate_tries   = 0;    // sends of the current entry
+static bool     hydrate_waiting = false;
+static bool     hydrate_done    = true;
+static bool     hydrate_got     = false; // current entry answered
+static uint32_t hydrate_sent    = 0;    // millis() of the last send
+static uint32_t hydrate_start   = 0;
+
+static void Hydrate_Add(uint8_t cmd, uint8_t band, uint8_t reg, uint8_t field)
+{
+    if (hydrate_count >= HYDRATE_STEPS_MAX)
+        return;
+    hydrate_list[hydrate_count].cmd   = cmd;
+    hydrate_list[hydrate_count].band  = band;
+    hydrate_list[hydrate_count].reg   = reg;
+    hydrate_list[hydrate_count].field = field;
+    hydrate_count++;
+}
+
+// Build the request list and start the background refresh.  Everything restored from SD is unconfirmed until the radio answers.
+// Radio_Model calls it again each time it picks a model, the list depends on the model.
+COLD void Hydrate_Start(void)
+{
+    const struct Radio_Model *model = Radio_Model_Get();
+
+    memset(bstack_status, 0, sizeof(bstack_status));
+    hydrate_count = 0;
+    if (NO_SEND)
+    {
+        hydrate_done = true;
+        DPRINTLNF("Hydrate_Start: NO_SEND 1, nothing requested");
+        return;
+    }
+
+    // frequency and mode first, after a link loss these are the ones the band decode is waiting on
+    Hydrate_Add(CIV_C_F_READ, 0, 0, RS_FREQ);
+    if (Radio_Model_Has(RM_CMD_F26))
+        Hydrate_Add(CIV_C_F26A, 0, 0, RS_MODE);
+    else
+        Hydrate_Add(CIV_C_MOD_READ, 0, 0, RS_MODE);
+    if (Radio_Model_Has(RM_CMD_UTC))
+        Hydrate_Add(model->utc_cmd, 0, 0, RS_FIELDS);
+    if (Radio_Model_Has(RM_CMD_GPS))
+        Hydrate_Add(CIV_C_MY_POSIT_READ, 0, 0, RS_FIELDS);
+
+    // radio band stack band codes are mapped to our band index in check_CIV()
+    for (uint8_t i = 0; i < model->bstack_num; i++)
+        for (uint8_t j = 1; j <= BSTACK_REGS; j++)
+            Hydrate_Add(CIV_C_BSTACK, model->bstack[i].code, j, RS_FIELDS);
+
+    hydrate_idx     = 0;
+    hydrate_tries   = 0;
+    hydrate_waiting = false;
+    hydrate_done    = false;
+    hydrate_start   = millis();
+    DPRINTF("Hydrate_Start: "); DPRINT(hydrate_count); DPRINTLNF(" requests queued");
+}
+
+bool Hydrate_Busy(void)
+{
+    return !hydrate_done;
+}
+
+static void Hydrate_Send(struct Hydrate_Step *s)
+{
+    uint8_t data_str[3] = {};
+
+    if (s->cmd == CIV_C_BSTACK)
+    {
+        data_str[0] = 2;
+        data_str[1] = s->band;
+        data_str[2] = s->reg;
+        civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[s->cmd].cmdData), data_str, CIV_wFast);
+    }
+    else
+        civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[s->cmd].cmdData), CIV_D_NIX, CIV_wFast);
+
+    hydrate_sent    = millis();
+    hydrate_got     = false;
+    hydrate_waiting = true;
+    hydrate_tries++;
+}
+
+// Call every loop pass.  Does at most one send or one receive check, never blocks.
+PLACE(Hydrate_Service) void Hydrate_Service(void)
+{
+    PROF(Hydrate_Service);
+    struct Hydrate_Step *s;
+
+    if (hydrate_done)
+        return;
+
+    if (user_settings[user_Profile].xmit)   // stay off the bus while transmitting
+        return;
+
+    s = &hydrate_list[hydrate_idx];
+
+    if (!hydrate_waiting)
+    {
+        Hydrate_Send(s);
+        return;
+    }
+
+    Check_radio();  // BStack_Confirm() and Hydrate_Confirm() set hydrate_got from in here, or from another service's read
+    if (s->field < RS_FIELDS && RS_Source(s->field) == RS_SRC_RADIO && RS_Age(s->field) <= (millis() - hydrate_sent))
+        hydrate_got = true;
+
+    if (!hydrate_got)
+    {
+        if ((millis() - hydrate_sent) < HYDRATE_REPLY_MS)
+            return;
+        if (hydrate_tries <= HYDRATE_RETRIES)
+        {
+            Hydrate_Send(s);
+            return;
+        }
+        DPRINTF("Hydrate_Service: no reply, skipping request "); DPRINTLN(hydrate_idx);
+    }
+
+    hydrate_waiting = false;
+    hydrate_tries   = 0;
+    if (++hydrate_idx >= hydrate_count)
+    {
+        hydrate_done = true;
+        DPRINTF("Hydrate_Service: Complete in "); DPRINT(millis() - hydrate_start); DPRINTLNF("ms");
+        if (sdSetup) write_db_tables();   // keep the refreshed snapshot for the next boot
+    }
+}
+
+// Called from check_CIV() when a band stack reply has been stored in bandmem[]
+void BStack_Confirm(uint8_t band, uint8_t reg)
+{
+    if (band >= BANDS || reg < 1 || reg > BSTACK_REGS)
+        return;
+    bstack_status[band][reg-1].updated   = millis();
+    bstack_status[band][reg-1].confirmed = 1;
+
+    // hydrate_list[] holds the radio's band code, band here is already our index
+    if (!hydrate_done && hydrate_waiting && hydrate_list[hydrate_idx].cmd == CIV_C_BSTACK && hydrate_list[hydrate_idx].reg == reg &&
+        Radio_Model_BStack_Band(hydrate_list[hydrate_idx].band) == band)
+        hydrate_got = true;
+}
+
+// Called from check_CIV() for a reply with nothing in the radio state model.  cmd is the cmd_List[] index asked for.
+void Hydrate_Confirm(uint8_t cmd)
+{
+    if (!hydrate_done && hydrate_waiting && hydrate_list[hydrate_idx].cmd == cmd)
+        hydrate_got = true;
+}
+
+// Band() moves slot 1 to 0, 2 to 1 and 0 to 2.  Keep the status with its data.
+void BStack_Rotate(uint8_t band)
+{
+    struct BStack_Status temp;
+
+    if (band >= BANDS)
+        return;
+    temp                   = bstack_status[band][0];
+    bstack_status[band][0] = bstack_status[band][1];
+    bstack_status[band][1] = bstack_status[band][2];
+    bstack_status[band][2] = temp;
+}
+
+uint32_t BStack_Age(uint8_t band, uint8_t slot)
+{
+    if (band >= BANDS || slot >= BSTACK_REGS || !bstack_status[band][slot].confirmed)
+        return 0xFFFFFFFF;
+    return millis() - bstack_status[band][slot].updated;
+}
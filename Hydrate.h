@@ -0,0 +1,30 @@
+#ifndef _HYDRATE_H_
+#define _HYDRATE_H_
+//
+//  Hydrate.h
+//
+//  Startup state hydration.  The SD card snapshot (read_db_tables) gets the display and band decode up right away,
+//  then the radio's band stack registers and other state are fetched in the background, one request per loop pass,
+//  without the blocking delays the old setup() loop needed.
+//
+#include <Arduino.h>
+
+#define BSTACK_REGS         3       // radio band stack registers per band, 1 = newest
+
+// Per bandstack entry freshness.  Slot 0 = vfo_A_last, 1 = vfo_A_last_1, 2 = vfo_A_last_2 in bandmem[]
+struct BStack_Status {
+    uint32_t updated;               // millis() when the radio last reported this entry. 0 = never this session
+    uint8_t  confirmed;             // 1 = contents came from the radio, 0 = from SD snapshot or compiled defaults
+};
+
+extern struct BStack_Status bstack_status[][BSTACK_REGS];
+
+void Hydrate_Start(void);
+void Hydrate_Service(void);
+bool Hydrate_Busy(void);
+void BStack_Confirm(uint8_t band, uint8_t reg);     // reg is the radio register number 1-3
+void Hydrate_Confirm(uint8_t cmd);                  // a reply to a cmd_List[] request that sets no radio state field
+void BStack_Rotate(uint8_t band);                   // follows the bandstack shuffle done in Band()
+uint32_t BStack_Age(uint8_t band, uint8_t slot);    // ms since last confirmed, 0xFFFFFFFF if never
+
+#endif // _HYDRATE_H_
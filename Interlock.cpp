@@ -0,0 +1,185 @@
+//
+//  Interlock.cpp
+//
+//  Inputs are sampled every INTERLOCK_SAMPLE_US by an IntervalTimer so the time to RX does not depend on how long a
+//  main loop pass takes.  When an input has read faulted for its debounce count the interrupt drives PTT_OUT1 and the
+//  band decode PTT pins to RX directly, the same way the watchdog does, and records the latency.
+//  Interlock_Service() then does the parts that cannot run in an interrupt: CI-V TX off, Xmit(0) and the screen.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Controls.h"
+#include "Display.h"
+#include "Band_Table.h"
+#include "Interlock.h"
+#include "Event_Log.h"
+#include "Radio_Model.h"
+#include "Link.h"
+#include "No_Heap.h"
+
+extern CIV civ;
+extern struct cmdList cmd_List[];
+extern struct Label labels[];
+extern struct User_Settings user_settings[];
+extern uint8_t user_Profile;
+
+#define INTERLOCK_SAMPLE_US     1000
+
+struct Interlock_Input {
+    uint8_t pin;
+    uint8_t level;          // pin level that means fault
+    uint8_t debounce;       // samples
+};
+
+static const struct Interlock_Input il_inputs[INTERLOCK_INPUTS] = {
+    {INTERLOCK_0_PIN, INTERLOCK_0_LEVEL, INTERLOCK_0_DEBOUNCE},
+    {INTERLOCK_1_PIN, INTERLOCK_1_LEVEL, INTERLOCK_1_DEBOUNCE},
+    {INTERLOCK_2_PIN, INTERLOCK_2_LEVEL, INTERLOCK_2_DEBOUNCE}
+};
+
+static IntervalTimer il_timer;
+static volatile uint8_t  il_count[INTERLOCK_INPUTS];    // consecutive faulted samples
+static volatile uint32_t il_first[INTERLOCK_INPUTS];    // micros() of the first faulted sample
+static volatile uint8_t  il_active   = 0;               // inputs faulted now, debounced
+static volatile uint8_t  il_latched  = 0;               // inputs that faulted since the last clear
+static volatile uint8_t  il_new      = 0;               // latched by the interrupt, not yet handled by the service
+static volatile uint8_t  il_injected = 0;
+static struct Interlock_Stats il_stats;
+static volatile uint32_t il_latency_us;                 // written by the interrupt, folded into il_stats by the service
+
+// PTT outputs only, the band decode stays where it is.  Safe in an interrupt.
+static void Interlock_RX(void)
+{
+    if (PTT_OUT1 != GPIO_PIN_NOT_USED)
+        digitalWrite(PTT_OUT1, HIGH);   // HIGH = RX
+    for (uint8_t i = 0; i < BAND_DECODE_BITS; i++)
+        if (band_decode_ptt_pins[i] != GPIO_PIN_NOT_USED)
+            digitalWrite(band_decode_ptt_pins[i], LOW);
+}
+
+static void Interlock_Sample(void)
+{
+    uint32_t now = micros();
+    uint8_t  faulted;
+
+    for (uint8_t i = 0; i < INTERLOCK_INPUTS; i++)
+    {
+        faulted = (il_injected & (1 << i)) ||
+                  (il_inputs[i].pin != GPIO_PIN_NOT_USED && digitalReadFast(il_inputs[i].pin) == il_inputs[i].level);
+        if (!faulted)
+        {
+            il_count[i] = 0;
+            il_active  &= ~(1 << i);
+            continue;
+        }
+        if (il_count[i] == 0)
+            il_first[i] = now;
+        if (il_count[i] < 255)
+            il_count[i]++;
+        if (il_count[i] >= il_inputs[i].debounce && !(il_active & (1 << i)))
+        {
+            il_active  |= (1 << i);
+            il_latched |= (1 << i);
+            il_new     |= (1 << i);
+            Interlock_RX();
+            il_latency_us = micros() - il_first[i];
+            Event_Log_Record(EVT_INTERLOCK, i, il_latency_us > 0xFFFF ? 0xFFFF : il_latency_us);
+        }
+    }
+}
+
+COLD void Interlock_Init(void)
+{
+    uint8_t used = 0;
+
+    for (uint8_t i = 0; i < INTERLOCK_INPUTS; i++)
+    {
+        if (il_inputs[i].pin == GPIO_PIN_NOT_USED)
+            continue;
+        pinMode(il_inputs[i].pin, il_inputs[i].level == LOW ? INPUT_PULLUP : INPUT_PULLDOWN);
+        used++;
+    }
+    il_timer.begin(Interlock_Sample, INTERLOCK_SAMPLE_US);
+    DPRINTF("Interlock_Init: "); DPRINT(used); DPRINTLNF(" fault inputs");
+}
+
+static void Interlock_Alert(void)
+{
+    strcpy(labels[XMIT_LBL].label, il_latched ? "FLT" : Link_Lost() ? "LINK" : "XMIT");
+    displayXMIT();
+}
+
+PLACE(Interlock_Service) void Interlock_Service(void)
+{
+    PROF(Interlock_Service);
+    uint8_t  fresh;
+    uint32_t latency;
+
+    if (!il_new)
+        return;
+    noInterrupts();
+    fresh   = il_new;
+    latency = il_latency_us;
+    il_new  = 0;
+    interrupts();
+
+    il_stats.faults++;
+    il_stats.last_latency_us = latency;
+    if (latency > il_stats.max_latency_us)
+        il_stats.max_latency_us = latency;
+
+    DPRINTF("Interlock_Service: Fault on input mask "); DPRINT(fresh, BIN); DPRINTF("  RX in "); DPRINT(latency); DPRINTLNF("us");
+
+    if (INTERLOCK_CIV_TX_OFF)
+    {
+        uint8_t data_str[2] = {1, 0x00};    // TX off
+        civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_TX].cmdData), data_str, CIV_wFast);
+    }
+    if (user_settings[user_Profile].xmit)
+        Xmit(0);
+    Interlock_Alert();
+}
+
+bool Interlock_PTT_OK(void)
+{
+    return !il_latched && !il_active;
+}
+
+bool Interlock_Latched(void)
+{
+    return il_latched != 0;
+}
+
+bool Interlock_Clear(void)
+{
+    if (il_active)
+    {
+        DPRINTLNF("Interlock_Clear: Fault still active");
+        return false;
+    }
+    il_latched = 0;
+    Interlock_Alert();
+    DPRINTLNF("Interlock_Clear: Fault latch cleared");
+    return true;
+}
+
+// Test hook.  Measure the fault to RX time with PTT keyed, then read it with Interlock_Get_Stats().
+COLD void Interlock_Inject(uint8_t input, bool on)
+{
+    if (input >= INTERLOCK_INPUTS)
+        return;
+    noInterrupts();
+    if (on)
+        il_injected |= (1 << input);
+    else
+        il_injected &= ~(1 << input);
+    interrupts();
+    DPRINTF("Interlock_Inject: Input "); DPRINT(input); DPRINTLN(on ? " faulted" : " released");
+}
+
+const struct Interlock_Stats * Interlock_Get_Stats(void)
+{
+    return &il_stats;
+}
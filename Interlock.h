@@ -0,0 +1,28 @@
+#ifndef _INTERLOCK_H_
+#define _INTERLOCK_H_
+//
+//  Interlock.h
+//
+//  External fault inputs such as amplifier fault, high SWR or sequencer not ready.  Pins, levels and debounce are set
+//  with the INTERLOCK_x_ defines in RadioConfig.h.  A fault forces RX from the sampling interrupt, blocks PTT through
+//  PTT_Output() and Xmit() and stays latched on screen until the operator clears it.
+//
+#include <Arduino.h>
+
+#define INTERLOCK_INPUTS    3
+
+struct Interlock_Stats {
+    uint32_t faults;            // fault edges seen
+    uint32_t last_latency_us;   // first fault sample to PTT outputs in RX
+    uint32_t max_latency_us;
+};
+
+void Interlock_Init(void);                      // set up the pins and start sampling
+void Interlock_Service(void);                   // call every loop pass.  Radio TX off, screen and log for new faults
+bool Interlock_PTT_OK(void);                    // false while any fault is active or latched
+bool Interlock_Latched(void);
+bool Interlock_Clear(void);                     // clear the latch if every input is back to normal
+void Interlock_Inject(uint8_t input, bool on);  // test: force an input to read as faulted
+const struct Interlock_Stats * Interlock_Get_Stats(void);
+
+#endif // _INTERLOCK_H_
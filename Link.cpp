@@ -0,0 +1,184 @@
+//
+//  Link.cpp
+//
+//  The link is judged only by frames from the radio reaching check_CIV().  The TX poll and transceive reports keep it
+//  fresh in normal use, the ID query is only sent when those have been quiet for LINK_PROBE_MS.  The USB host side
+//  is inside CIVmasterLib, a replugged cable shows up here as the same silence then frames again as a power cycle.
+//  While lost, Radio_Model_Detect() is restarted every LINK_PROBE_MS once the previous pass and its hydration are done,
+//  so a different radio plugged in is found at its own address.
+//  The main loop does not read the port itself, so the reply to a probe is read here until it comes in or
+//  HYDRATE_REPLY_MS runs out.
+//  With NO_SEND 1 nothing is sent and detection only listens.  The port is read here on every pass, and the link is
+//  judged from whatever the radio sends on its own or in answer to a PC program.  An idle radio can be quiet for a
+//  long time, so only LINK_QUIET_MS of silence counts as a loss then.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Controls.h"
+#include "Display.h"
+#include "Hydrate.h"
+#include "Interlock.h"
+#include "Event_Log.h"
+#include "Radio_Model.h"
+#include "Link.h"
+#include "No_Heap.h"
+
+extern CIV civ;
+extern struct cmdList cmd_List[];
+extern struct Label labels[];
+extern struct User_Settings user_settings[];
+extern uint8_t user_Profile;
+extern uint8_t curr_band;
+extern uint8_t Check_radio(void);
+
+static struct Link_Stats link_stats;
+static bool     link_lost    = false;
+static bool     link_dropped = false;
+static bool     link_probing = false;   // ID query out, reading the port for the reply
+static uint32_t link_frame   = 0;       // millis() of the last valid frame
+static uint32_t link_probe   = 0;       // millis() of the last ID query or detection restart
+static uint32_t link_since   = 0;       // millis() of the last frame before the loss
+
+static void Link_Alert(void)
+{
+    strcpy(labels[XMIT_LBL].label, Interlock_Latched() ? "FLT" : link_lost ? "LINK" : "XMIT");
+    displayXMIT();
+}
+
+COLD void Link_Init(void)
+{
+    link_frame = link_probe = millis();     // the radio gets LINK_LOST_MS from here to answer
+}
+
+HOT void Link_Frame(void)
+{
+    link_frame   = millis();
+    link_probing = false;
+    link_stats.frames++;
+}
+
+static void Link_Lose(uint32_t now)
+{
+    link_lost  = true;
+    link_since = link_frame;
+    link_probe = now - LINK_PROBE_MS;       // start looking for the radio on this pass
+    link_stats.losses++;
+    Event_Log_Record(EVT_LINK, 0, (now - link_frame) / 1000);
+    DPRINTLNF("Link_Service: CI-V link lost");
+
+    #if LINK_SAFE_OUTPUTS
+        if (user_settings[user_Profile].xmit)
+            Xmit(0);
+        PTT_Output(curr_band, 0);
+        #if LINK_SAFE_OUTPUTS > 1
+            GPIO_Out(LINK_SAFE_DECODE);
+        #endif
+    #endif
+    Link_Alert();
+}
+
+static void Link_Restore(void)
+{
+    uint32_t outage = link_frame - link_since;
+
+    link_lost = false;
+    link_stats.last_outage_ms = outage;
+    if (outage > link_stats.max_outage_ms)
+        link_stats.max_outage_ms = outage;
+    Event_Log_Record(EVT_LINK, 1, outage / 1000);
+    DPRINTF("Link_Service: CI-V link back after "); DPRINT(outage); DPRINTLNF("ms");
+
+    #if LINK_SAFE_OUTPUTS > 1
+        Band_Decode_Output(curr_band);
+    #endif
+    Link_Alert();
+    Radio_Model_Detect();   // could be another radio now, then everything is fetched again for it
+}
+
+PLACE(Link_Service) void Link_Service(void)
+{
+    PROF(Link_Service);
+    uint32_t now = millis();
+
+    if (NO_SEND || link_probing)
+    {
+        Check_radio();      // frames come back through Link_Frame()
+        now = millis();
+        if (link_probing && (now - link_probe) >= HYDRATE_REPLY_MS)
+            link_probing = false;
+    }
+
+    if (link_lost)
+    {
+        if (link_frame != link_since)
+            Link_Restore();
+        else if ((now - link_probe) >= LINK_PROBE_MS && !Radio_Model_Busy() && !Hydrate_Busy())
+        {
+            link_probe = now;
+            link_stats.probes++;
+            Radio_Model_Detect();
+        }
+        return;
+    }
+
+    if ((now - link_frame) >= (NO_SEND ? LINK_QUIET_MS : LINK_LOST_MS))
+    {
+        Link_Lose(now);
+        return;
+    }
+
+    // quiet but not lost yet, ask for something small.  Detection and hydration are already asking.
+    if (!NO_SEND && (now - link_frame) >= LINK_PROBE_MS && (now - link_probe) >= LINK_PROBE_MS && !Radio_Model_Busy() && !Hydrate_Busy())
+    {
+        link_probe   = now;
+        link_probing = true;
+        link_stats.probes++;
+        civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_TRX_ID].cmdData), CIV_D_NIX, CIV_wFast);
+    }
+}
+
+bool Link_Lost(void)
+{
+    return link_lost;
+}
+
+bool Link_PTT_OK(void)
+{
+    return LINK_SAFE_OUTPUTS == 0 || !link_lost;
+}
+
+// Test hook.  check_CIV() throws away every frame while on, the silence then runs the real loss and recovery.
+COLD void Link_Drop(bool on)
+{
+    link_dropped = on;
+    DPRINTLN(on ? "Link_Drop: Ignoring the radio" : "Link_Drop: Listening to the radio again");
+}
+
+bool Link_Dropped(void)
+{
+    return link_dropped;
+}
+
+const struct Link_Stats * Link_Get_Stats(void)
+{
+    return &link_stats;
+}
+
+// Same rule as CIV_Stats_Show_Stats(), only when something changed other than the frame count
+COLD void Link_Show_Stats(void)
+{
+    static uint32_t last_probes = 0, last_losses = 0;
+
+    if (link_stats.probes == last_probes && link_stats.losses == last_losses)
+        return;
+    last_probes = link_stats.probes;
+    last_losses = link_stats.losses;
+
+    DPRINTF("Link: frames="); DPRINT(link_stats.frames);
+    DPRINTF(" probes="); DPRINT(link_stats.probes);
+    DPRINTF(" losses="); DPRINT(link_stats.losses);
+    DPRINTF(" outage_ms="); DPRINT(link_stats.last_outage_ms);
+    DPRINTF(" max_outage_ms="); DPRINTLN(link_stats.max_outage_ms);
+}
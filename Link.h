@@ -0,0 +1,32 @@
+#ifndef _LINK_H_
+#define _LINK_H_
+//
+//  Link.h
+//
+//  CI-V link supervisor.  Every valid frame from the radio refreshes the link, a quiet link gets an ID query every
+//  LINK_PROBE_MS, and LINK_LOST_MS with nothing heard is a loss: the outputs go to the LINK_SAFE_OUTPUTS state, the
+//  XMIT label reads LINK and radio detection restarts.  The first frame after that restores the outputs and detection
+//  then fetches the radio state again, so a power cycled radio or a replugged cable picks up where it was.
+//  With NO_SEND 1 there are no queries, the link is judged from the frames the radio sends anyway over LINK_QUIET_MS.
+//
+#include <Arduino.h>
+
+struct Link_Stats {
+    uint32_t frames;            // valid frames from the radio
+    uint32_t probes;            // keep-alive ID queries and detection restarts
+    uint32_t losses;
+    uint32_t last_outage_ms;    // last frame before the loss to the first one after it
+    uint32_t max_outage_ms;
+};
+
+void Link_Init(void);                   // start the silence timer
+void Link_Service(void);                // call every loop pass.  Probe, loss and recovery
+void Link_Frame(void);                  // check_CIV() on every valid frame
+bool Link_Lost(void);
+bool Link_PTT_OK(void);                 // false while lost and LINK_SAFE_OUTPUTS holds PTT in RX
+void Link_Drop(bool on);                // test: ignore everything the radio sends, as if the cable were out
+bool Link_Dropped(void);
+const struct Link_Stats * Link_Get_Stats(void);
+void Link_Show_Stats(void);
+
+#endif // _LINK_H_
@@ -0,0 +1,128 @@
+//
+//  Mem_Stats.cpp
+//
+//  Teensy 4 layout: ITCM code and DTCM variables share RAM1 in 32K blocks, the stack grows down from the top of DTCM
+//  towards the variables.  DMAMEM variables sit at the bottom of RAM2 and the heap takes the rest of it.
+//  Region sizes come from the linker symbols the core's startup code uses.
+//  Mem_Init() fills the free stack with MEM_CANARY, the high-water mark is the lowest word that was overwritten.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Event_Log.h"
+#include "Mem_Stats.h"
+#include <malloc.h>
+
+#ifdef USE_RA8875
+    extern RA8875 tft;
+#else
+    extern RA8876_t3 tft;
+#endif
+
+extern unsigned long _stext, _etext, _sdata, _ebss, _estack, _heap_start, _heap_end, _itcm_block_count;
+
+#define MEM_CANARY          0xC0DEDBADUL
+#define MEM_RAM2_START      0x20200000UL
+#define MEM_PAINT_MARGIN    256     // bytes below the live stack pointer left alone
+
+static struct Mem_Stats mem;
+static uint32_t mem_check       = 0;    // millis() of the last measurement
+static uint32_t mem_logged_kb[2];       // stack, heap high-water already in the flight recorder
+static bool     mem_warned      = false;
+
+COLD void Mem_Init(void)
+{
+    uint32_t *p = (uint32_t *) &_ebss;
+    uint32_t sp;
+
+    __asm__ volatile("mov %0, sp" : "=r" (sp));
+    while ((uint32_t) p < sp - MEM_PAINT_MARGIN)
+        *p++ = MEM_CANARY;
+}
+
+static void Mem_Measure(void)
+{
+    const uint32_t *p  = (const uint32_t *) &_ebss;
+    const uint32_t *sp = (const uint32_t *) &_estack;
+    struct mallinfo mi = mallinfo();
+
+    mem.itcm_size  = (uint32_t) &_itcm_block_count * 32768;
+    mem.itcm_code  = (uint32_t) &_etext - (uint32_t) &_stext;
+    mem.dtcm_data  = (uint32_t) &_ebss - (uint32_t) &_sdata;
+    mem.stack_size = (uint32_t) &_estack - (uint32_t) &_ebss;
+    while (p < sp && *p == MEM_CANARY)
+        p++;
+    mem.stack_used = (uint32_t) &_estack - (uint32_t) p;
+
+    mem.dmamem          = (uint32_t) &_heap_start - MEM_RAM2_START;
+    mem.heap_size       = (uint32_t) &_heap_end - (uint32_t) &_heap_start;
+    mem.heap_used       = mi.uordblks;
+    mem.heap_free       = mem.heap_size - mi.arena + mi.fordblks;
+    mem.heap_fragmented = mi.fordblks;
+
+    mem.tables = BANDS * sizeof(struct Band_Memory) + STD_BTN_NUM * sizeof(struct Standard_Button) +
+                 LABEL_NUM * sizeof(struct Label) + USER_SETTINGS_NUM * sizeof(struct User_Settings) +
+                 NUM_AUX_ENCODERS * sizeof(struct EncoderList);
+}
+
+// New high-water marks go in the flight recorder in whole KB
+static void Mem_Log(uint8_t which, uint32_t bytes)
+{
+    uint32_t kb = (bytes + 1023) / 1024;
+
+    if (kb <= mem_logged_kb[which])
+        return;
+    mem_logged_kb[which] = kb;
+    Event_Log_Record(EVT_MEM, which, kb);
+}
+
+PLACE(Mem_Service) void Mem_Service(void)
+{
+    PROF(Mem_Service);
+    uint32_t now = millis();
+
+    if (mem_check && (now - mem_check) < MEM_CHECK_MS)
+        return;
+    mem_check = now;
+
+    Mem_Measure();
+    Mem_Log(0, mem.stack_used);
+    Mem_Log(1, mem.heap_used);
+
+    if (!mem_warned && mem.stack_size - mem.stack_used < MEM_STACK_MIN_FREE)
+    {
+        mem_warned = true;
+        DPRINTF("Mem_Service: ***** Stack high-water leaves "); DPRINT(mem.stack_size - mem.stack_used); DPRINTLNF(" bytes free");
+    }
+}
+
+COLD void Mem_Report(void)
+{
+    Mem_Measure();
+    PC_Debug_port.printf("Mem_Report: RAM1 ITCM code %lu of %lu  DTCM variables %lu  Stack %lu of %lu used\n",
+        mem.itcm_code, mem.itcm_size, mem.dtcm_data, mem.stack_used, mem.stack_size);
+    PC_Debug_port.printf("Mem_Report: RAM2 DMAMEM %lu  Heap %lu used, %lu free of %lu, %lu of the free is fragmented\n",
+        mem.dmamem, mem.heap_used, mem.heap_free, mem.heap_size, mem.heap_fragmented);
+    PC_Debug_port.printf("Mem_Report: Tables in DTCM %lu  bandmem %u  std_btn %u  labels %u  user_settings %u  encoder_list %u\n", mem.tables,
+        BANDS * sizeof(struct Band_Memory), STD_BTN_NUM * sizeof(struct Standard_Button), LABEL_NUM * sizeof(struct Label),
+        USER_SETTINGS_NUM * sizeof(struct User_Settings), NUM_AUX_ENCODERS * sizeof(struct EncoderList));
+}
+
+uint16_t Mem_Show(uint16_t x, uint16_t y)
+{
+    char line[64];
+
+    Mem_Measure();
+    snprintf(line, sizeof(line), "Stack %luK of %luK  Code %luK of %luK", mem.stack_used / 1024, mem.stack_size / 1024, mem.itcm_code / 1024, mem.itcm_size / 1024);
+    tft.setCursor(x, y);
+    tft.print(line);
+    snprintf(line, sizeof(line), "Heap %luK used %luK free %luK frag  Tables %luK", mem.heap_used / 1024, mem.heap_free / 1024, mem.heap_fragmented / 1024, mem.tables / 1024);
+    tft.setCursor(x, y + 22);
+    tft.print(line);
+    return y + 44;
+}
+
+const struct Mem_Stats * Mem_Get_Stats(void)
+{
+    return &mem;
+}
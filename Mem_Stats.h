@@ -0,0 +1,32 @@
+#ifndef _MEM_STATS_H_
+#define _MEM_STATS_H_
+//
+//  Mem_Stats.h
+//
+//  Memory telemetry.  Stack high-water mark from a canary painted at boot, heap use and fragmentation, and how
+//  RAM1 (ITCM code, DTCM variables and stack) and RAM2 (DMAMEM, heap) are split.  Shown on the diagnostics popup,
+//  printed on the Debug port and new high-water marks go in the flight recorder.
+//
+#include <Arduino.h>
+
+struct Mem_Stats {
+    uint32_t itcm_code;         // RAM1 code, FASTRUN and HOT functions
+    uint32_t itcm_size;         // RAM1 given to code, whole 32K blocks
+    uint32_t dtcm_data;         // RAM1 variables, initialized and zeroed
+    uint32_t stack_size;        // RAM1 left over for the stack
+    uint32_t stack_used;        // high-water mark
+    uint32_t dmamem;            // RAM2 DMAMEM variables
+    uint32_t heap_size;         // RAM2 after DMAMEM
+    uint32_t heap_used;         // allocated now
+    uint32_t heap_free;         // never taken from the system plus freed blocks
+    uint32_t heap_fragmented;   // of heap_free, freed blocks stranded below the top of the heap
+    uint32_t tables;            // bandmem, std_btn, labels, user_settings and encoder_list, all in DTCM
+};
+
+void Mem_Init(void);                        // first thing in setup().  Paints the free stack with the canary
+void Mem_Service(void);                     // call every loop pass.  Measures every MEM_CHECK_MS
+void Mem_Report(void);                      // everything to the Debug port
+uint16_t Mem_Show(uint16_t x, uint16_t y);  // summary lines on the diagnostics popup, returns the next free line
+const struct Mem_Stats * Mem_Get_Stats(void);
+
+#endif // _MEM_STATS_H_
@@ -0,0 +1,98 @@
+//
+//  Mode_Map.cpp
+//
+//  mode_map[][] is indexed by the radio's mode byte as sent (0x17 for DV) and the data flag.  When two modeList[]
+//  entries share a combination the first one wins, the same as the old linear search.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include <CIVmaster.h>
+#include "Mode_Map.h"
+#include "Radio_Model.h"
+#include "No_Heap.h"
+
+extern struct Modes_List modeList[];
+
+// Mode bytes the radios report and whether DATA can be on in that mode.  From the Icom CI-V references.
+struct Mode_Radio {
+    uint8_t mode_num;
+    uint8_t need;           // RM_MODE_xxx the model must have, 0 = every model
+    uint8_t data_ok;
+};
+
+PROGMEM static const struct Mode_Radio mode_radio[] = {
+    {0x00, 0,           1},     // LSB
+    {0x01, 0,           1},     // USB
+    {0x02, 0,           1},     // AM
+    {0x03, 0,           0},     // CW
+    {0x04, 0,           0},     // RTTY
+    {0x05, 0,           1},     // FM
+    {0x06, RM_MODE_WFM, 0},     // WFM, receive only
+    {0x07, 0,           0},     // CW-R
+    {0x08, 0,           0},     // RTTY-R
+    {0x17, RM_MODE_DV,  0},     // DV
+    {0x22, RM_MODE_DD,  0},     // DD, 1200MHz and up
+    {0x23, RM_MODE_ATV, 0}      // ATV, 1200MHz and up
+};
+
+static uint8_t mode_map[MODE_MAP_BYTES][2];
+static struct Mode_Map_Stats mode_stats;
+
+COLD uint8_t Mode_Map_Init(void)
+{
+    uint8_t modes = Radio_Model_Get()->modes;     // the model being checked against
+
+    memset(mode_map, MODE_NONE, sizeof(mode_map));
+    memset(&mode_stats, 0, sizeof(mode_stats));
+
+    for (uint8_t i = 0; i < MODES_NUM; i++)
+    {
+        uint8_t m = modeList[i].mode_num;
+        uint8_t d = modeList[i].data;
+
+        if (m >= MODE_MAP_BYTES || d > 1)
+        {
+            mode_stats.unmapped++;
+            DPRINTF("Mode_Map_Init: "); DPRINT(modeList[i].mode_label); DPRINTF(" mode byte "); DPRINT(m, HEX); DPRINTF(" data "); DPRINT(d); DPRINTLNF(" is out of range");
+            continue;
+        }
+        if (mode_map[m][d] != MODE_NONE)
+        {
+            mode_stats.ambiguous++;
+            DPRINTF("Mode_Map_Init: "); DPRINT(modeList[i].mode_label); DPRINTF(" repeats "); DPRINTLN(modeList[mode_map[m][d]].mode_label);
+            continue;
+        }
+        mode_map[m][d] = i;
+    }
+
+    for (uint8_t i = 0; i < sizeof(mode_radio) / sizeof(mode_radio[0]); i++)
+    {
+        if (mode_radio[i].need && !(mode_radio[i].need & modes))
+            continue;
+        for (uint8_t d = 0; d <= mode_radio[i].data_ok; d++)
+        {
+            if (mode_map[mode_radio[i].mode_num][d] != MODE_NONE)
+                continue;
+            mode_stats.missing++;
+            DPRINTF("Mode_Map_Init: no modeList entry for radio mode "); DPRINT(mode_radio[i].mode_num, HEX); DPRINTLN(d ? " with DATA" : "");
+        }
+    }
+
+    DPRINTF("Mode_Map_Init: "); DPRINT(MODES_NUM); DPRINTF(" modes, "); DPRINT(mode_stats.ambiguous); DPRINTF(" repeated, ");
+    DPRINT(mode_stats.unmapped); DPRINTF(" out of range, "); DPRINT(mode_stats.missing); DPRINTLNF(" missing");
+    return mode_stats.ambiguous + mode_stats.unmapped + mode_stats.missing;
+}
+
+PLACE(Mode_Map_Index) uint8_t Mode_Map_Index(uint8_t mode_num, uint8_t data)
+{
+    PROF(Mode_Map_Index);
+    if (mode_num >= MODE_MAP_BYTES || data > 1)
+        return MODE_NONE;
+    return mode_map[mode_num][data];
+}
+
+const struct Mode_Map_Stats * Mode_Map_Get_Stats(void)
+{
+    return &mode_stats;
+}
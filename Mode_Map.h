@@ -0,0 +1,25 @@
+#ifndef _MODE_MAP_H_
+#define _MODE_MAP_H_
+//
+//  Mode_Map.h
+//
+//  Radio mode byte and data flag to modeList[] index, by table instead of scanning modeList[] on every report.
+//  The other way is modeList[index] itself.  Built from modeList[] after it is read from the SD card and checked
+//  against the modes the active Radio_Model can report, and again whenever the model changes.
+//
+#include <Arduino.h>
+
+#define MODE_NONE           255     // no modeList[] entry for that mode and data combination
+#define MODE_MAP_BYTES      0x24    // radio mode bytes 0x00 to 0x23 (ATV)
+
+struct Mode_Map_Stats {
+    uint8_t ambiguous;      // modeList[] entries with the same mode and data as an earlier one, never returned
+    uint8_t unmapped;       // modeList[] entries with a mode byte outside the table or a bad data flag
+    uint8_t missing;        // modes the radio can report with no modeList[] entry
+};
+
+uint8_t Mode_Map_Init(void);                            // rebuild and check, returns the number of problems found
+uint8_t Mode_Map_Index(uint8_t mode_num, uint8_t data); // modeList[] index or MODE_NONE
+const struct Mode_Map_Stats * Mode_Map_Get_Stats(void);
+
+#endif // _MODE_MAP_H_
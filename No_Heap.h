@@ -0,0 +1,12 @@
+#ifndef _NO_HEAP_H_
+#define _NO_HEAP_H_
+//
+//  No_Heap.h
+//
+//  Include last in files on the CI-V, PTT and band decode paths.  From here on any use of String or the heap is a
+//  compile error.  The decoder runs for days with no way to report a fragmented heap, so these paths stay off it.
+//  Headers included earlier are not affected, the poison only applies to code that follows.
+//
+#pragma GCC poison String malloc calloc realloc free strdup
+
+#endif // _NO_HEAP_H_
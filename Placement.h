@@ -0,0 +1,47 @@
+#ifndef _PLACEMENT_H_
+#define _PLACEMENT_H_
+//
+//  Placement.h
+//
+//  RAM (HOT) or flash (COLD) for the functions counted by a PROFILE build, see Profile.h.
+//  Written by PythonApps/placement_gen.py from a profile.log, hand edits are lost on the next run.
+//  These are the hand placements the functions had before profiling, check in a generated file to replace them.
+//  Empty means the linker default, RAM1 like HOT without the hot attribute.
+//
+#define PLACE(f)    PLACE_##f
+
+#define PLACE_selectFrequency       COLD
+#define PLACE_SetFreq               COLD
+#define PLACE_find_new_band         HOT
+#define PLACE_displayFreq           COLD
+#define PLACE_formatVFO             COLD
+#define PLACE_displayMeter          COLD
+#define PLACE_drawLabel             COLD
+#define PLACE_draw_2_state_Button   COLD
+#define PLACE_Touch                 COLD
+#define PLACE_Gesture_Handler       COLD
+#define PLACE_Button_Handler        COLD
+#define PLACE_Peak                  COLD
+#define PLACE_Peak_avg              HOT
+#define PLACE_check_CIV
+#define PLACE_Hydrate_Service
+#define PLACE_RS_Service            HOT
+#define PLACE_TX_Timer_Service      HOT
+#define PLACE_Drive_Limit_Service   HOT
+#define PLACE_Band_Guard_Service    HOT
+#define PLACE_Interlock_Service     HOT
+#define PLACE_Event_Log_Service     HOT
+#define PLACE_Mem_Service           HOT
+#define PLACE_Watchdog_Service      HOT
+#define PLACE_Xvtr_RF_to_IF
+#define PLACE_Xvtr_IF_to_RF
+#define PLACE_WC_Service            HOT
+#define PLACE_WC_Write              HOT
+#define PLACE_Mode_Map_Index        HOT
+#define PLACE_Radio_Model_Service
+#define PLACE_Link_Service          HOT
+#define PLACE_Xcv_Service           HOT
+#define PLACE_CIV_Fault_Service
+#define PLACE_CIV_Fault_Filter      HOT
+
+#endif // _PLACEMENT_H_
@@ -0,0 +1,84 @@
+//
+//  Profile.cpp
+//
+//  Each PROF() scope reads the DWT cycle counter on entry and exit.  Self cycles leave out the time spent in profiled
+//  callees, so Touch() is not charged for Button_Handler().  Time in functions that are not profiled, including
+//  interrupts taken during the call, stays with the caller.
+//  The report columns are what PythonApps/placement_gen.py parses, keep them in step.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Mem_Stats.h"
+#include "Profile.h"
+#include "SD.h"
+
+#ifdef PROFILE
+
+#define PROF_FILE           "profile.log"
+
+extern bool sdSetup;
+
+struct Prof_Entry {
+    uint32_t calls;
+    uint32_t max;       // cycles, longest single call including callees
+    uint64_t self;      // cycles
+    uint64_t total;     // cycles including profiled callees
+};
+
+#define PROF_NAME(f)    #f,
+PROGMEM static const char prof_names[PROF_COUNT][24] = { PROF_FUNCS(PROF_NAME) };
+
+uint32_t prof_child = 0;
+static struct Prof_Entry prof[PROF_COUNT];
+static uint32_t prof_start  = 0;    // millis() at Prof_Init()
+static uint16_t prof_report = 0;
+
+HOT void Prof_Add(uint8_t id, uint32_t total, uint32_t self)
+{
+    prof[id].calls++;
+    prof[id].self  += self;
+    prof[id].total += total;
+    if (total > prof[id].max)
+        prof[id].max = total;
+}
+
+COLD void Prof_Init(void)
+{
+    memset(prof, 0, sizeof(prof));
+    prof_child = 0;
+    prof_start = millis();
+    DPRINTF("Prof_Init: Counting "); DPRINT(PROF_COUNT); DPRINTLNF(" functions");
+}
+
+// Cycle columns are in thousands so a long run fits in 32 bits
+static void Prof_Print(Print &out)
+{
+    const struct Mem_Stats *m = Mem_Get_Stats();
+
+    out.printf("Profile %u: %lu ms, %lu MHz, ITCM code %lu of %lu\n", prof_report, millis() - prof_start,
+               F_CPU_ACTUAL / 1000000, m->itcm_code, m->itcm_size);
+    out.printf("Prof %-20s %10s %12s %12s %10s\n", "function", "calls", "self_kcyc", "total_kcyc", "max_cyc");
+    for (uint8_t i = 0; i < PROF_COUNT; i++)
+        out.printf("Prof %-20s %10lu %12lu %12lu %10lu\n", prof_names[i], prof[i].calls,
+                   (uint32_t) (prof[i].self / 1000), (uint32_t) (prof[i].total / 1000), prof[i].max);
+}
+
+COLD void Prof_Report(void)
+{
+    File f;
+
+    prof_report++;
+    Prof_Print(PC_Debug_port);
+    if (sdSetup)
+    {
+        f = SD.open(PROF_FILE, FILE_WRITE);     // appends
+        if (f)
+        {
+            Prof_Print(f);
+            f.close();
+        }
+    }
+}
+
+#endif // PROFILE
@@ -0,0 +1,66 @@
+#ifndef _PROFILE_H_
+#define _PROFILE_H_
+//
+//  Profile.h
+//
+//  Call and cycle counts for the functions whose RAM or flash placement is managed in Placement.h.
+//  Build with PROFILE defined in RadioConfig.h, operate the radio normally for a while, then send PROFILE_REPORT_KEY
+//  on the Debug port.  The report also goes to profile.log on the SD card.
+//  PythonApps/placement_gen.py reads it with the build's ELF file and writes a new Placement.h that puts the functions
+//  with the most cycles per byte in ITCM within the budget.
+//
+//  PROF(name) goes first in the function body.  Main loop code only, the nesting bookkeeping is not interrupt safe.
+//  Without PROFILE it is empty.
+//
+#include <Arduino.h>
+
+// Profiled functions.  Add a PLACE_ line for each one to Placement.h
+#define PROF_FUNCS(X) \
+    X(selectFrequency)      X(SetFreq)              X(find_new_band)        \
+    X(displayFreq)          X(formatVFO)            X(displayMeter)         \
+    X(drawLabel)            X(draw_2_state_Button)                          \
+    X(Touch)                X(Gesture_Handler)      X(Button_Handler)       \
+    X(Peak)                 X(Peak_avg)                                     \
+    X(check_CIV)            X(Hydrate_Service)      X(RS_Service)           \
+    X(TX_Timer_Service)     X(Drive_Limit_Service)  X(Band_Guard_Service)   \
+    X(Interlock_Service)    X(Event_Log_Service)    X(Mem_Service)          \
+    X(Watchdog_Service)     X(Xvtr_RF_to_IF)        X(Xvtr_IF_to_RF)        \
+    X(WC_Service)           X(WC_Write)             X(Mode_Map_Index)       \
+    X(Radio_Model_Service)  X(Link_Service)         X(Xcv_Service)          \
+    X(CIV_Fault_Service)    X(CIV_Fault_Filter)
+
+#define PROF_ENUM(f)    PROF_ID_##f,
+enum Prof_Id { PROF_FUNCS(PROF_ENUM) PROF_COUNT };
+
+#ifdef PROFILE
+
+extern uint32_t prof_child;     // cycles spent in profiled callees of the innermost open scope
+
+void Prof_Add(uint8_t id, uint32_t total, uint32_t self);
+
+class Prof_Scope {
+  public:
+    Prof_Scope(uint8_t _id) : id(_id), child(prof_child), start(ARM_DWT_CYCCNT) { prof_child = 0; }
+    ~Prof_Scope()
+    {
+        uint32_t t = ARM_DWT_CYCCNT - start;
+
+        Prof_Add(id, t, t - prof_child);
+        prof_child = child + t;
+    }
+  private:
+    uint8_t  id;
+    uint32_t child;     // the enclosing scope's callee cycles so far
+    uint32_t start;
+};
+
+#define PROF(f)         Prof_Scope prof_scope(PROF_ID_##f)
+
+void Prof_Init(void);       // end of setup(), starts the counting window
+void Prof_Report(void);     // counts to the Debug port and profile.log
+
+#else
+#define PROF(f)
+#endif // PROFILE
+
+#endif // _PROFILE_H_
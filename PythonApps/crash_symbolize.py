@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# crash_symbolize.py
+#
+# Maps the addresses in a decoder crash report back to functions and source lines.
+# The report comes from crash.log on the SD card or the Debug port output at boot, see Crash.cpp.
+# Needs the ELF file from the same build, the Arduino IDE leaves it in its temporary build folder
+# (CIV-USB-Band-Decoder.ino.elf), and arm-none-eabi-addr2line from the Teensy toolchain.
+#
+# Usage:  crash_symbolize.py <build.elf> [crash.log]      reads stdin when no log file is given
+#
+
+import re
+import shutil
+import subprocess
+import sys
+
+ADDR2LINE = 'arm-none-eabi-addr2line'
+
+# Registers that hold code addresses.  The rest are data and are left alone.
+CODE_REGS = ('PC', 'LR')
+
+REG_RE = re.compile(r'\b(PC|LR|SP|xPSR|EXC_RETURN|R\d+|CFSR|HFSR|MMFAR|BFAR)\s+0x([0-9A-Fa-f]{8})')
+CRASH_RE = re.compile(r'^Crash \d+:')
+
+
+def parse_reports(lines):
+    """Split a log into reports.  Each is a list of lines starting with the 'Crash n:' line,
+    and a dict of register name to value."""
+    reports = []
+    for line in lines:
+        line = line.rstrip('\r\n')
+        if CRASH_RE.match(line):
+            reports.append(([line], {}))
+            continue
+        if not reports:
+            continue
+        text, regs = reports[-1]
+        text.append(line)
+        for name, value in REG_RE.findall(line):
+            regs[name] = int(value, 16)
+    return reports
+
+
+def symbolize(elf, addrs):
+    """Returns {addr: 'function at file:line'} using addr2line.  Thumb bit is cleared first."""
+    if not addrs:
+        return {}
+    if shutil.which(ADDR2LINE) is None:
+        sys.exit(ADDR2LINE + ' not found, add the Teensy toolchain bin folder to PATH')
+    addrs = sorted(set(addrs))
+    cmd = [ADDR2LINE, '-f', '-C', '-e', elf] + ['0x%08X' % (a & ~1) for a in addrs]
+    out = subprocess.run(cmd, stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout.splitlines()
+    # addr2line prints two lines per address, function then file:line
+    return {a: '%s at %s' % (out[2 * i], out[2 * i + 1]) for i, a in enumerate(addrs)}
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.exit('usage: crash_symbolize.py <build.elf> [crash.log]')
+    elf = argv[1]
+    src = open(argv[2]) if len(argv) > 2 else sys.stdin
+    reports = parse_reports(src)
+    if not reports:
+        sys.exit('no crash reports found')
+
+    addrs = [regs[r] for _, regs in reports for r in CODE_REGS if r in regs]
+    names = symbolize(elf, addrs)
+
+    for text, regs in reports:
+        print('\n'.join(text))
+        for r in CODE_REGS:
+            if r in regs:
+                print('  %-3s %s' % (r, names[regs[r]]))
+        print()
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# placement_gen.py
+#
+# Writes Placement.h from a PROFILE build's report, see Profile.h.
+# The profiled functions are ranked by self cycles per byte of code and placed HOT (ITCM) in that order until the
+# budget is used, the rest go COLD (flash).  Sizes and current locations come from the ELF of the profiled build,
+# which the Arduino IDE leaves in its temporary build folder (CIV-USB-Band-Decoder.ino.elf).
+# Needs arm-none-eabi-nm from the Teensy toolchain.
+#
+# The default budget is the free space in the ITCM blocks already allocated plus what the profiled functions
+# in ITCM use now, so the new placement does not take another 32K block from DTCM.
+#
+# Flash code runs through the 32K instruction cache, a miss stalls for a FlexSPI read.  The savings estimate
+# assumes --penalty percent of a flash function's self cycles are those stalls.  It is an estimate, compare the
+# self cycles of a second profile run with the new Placement.h to see the real change.
+#
+# Usage:  placement_gen.py <build.elf> <profile.log> [-o Placement.h] [--budget bytes] [--penalty pct]
+#
+
+import argparse
+import re
+import shutil
+import subprocess
+import sys
+
+NM = 'arm-none-eabi-nm'
+
+ITCM_END = 0x00080000       # code below this runs from ITCM, FLASHMEM code is at 0x60000000 and up
+
+HEAD_RE = re.compile(r'^Profile (\d+): (\d+) ms, (\d+) MHz, ITCM code (\d+) of (\d+)')
+PROF_RE = re.compile(r'^Prof (\w+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)')
+
+
+def parse_profile(lines):
+    """Returns the last report in the log, (header dict, {function: (calls, self_kcyc, total_kcyc, max_cyc)})."""
+    head, funcs = None, {}
+    for line in lines:
+        m = HEAD_RE.match(line)
+        if m:
+            head = dict(zip(('report', 'ms', 'mhz', 'itcm_code', 'itcm_size'), map(int, m.groups())))
+            funcs = {}
+            continue
+        m = PROF_RE.match(line)
+        if m and head:
+            funcs[m.group(1)] = tuple(map(int, m.groups()[1:]))
+    return head, funcs
+
+
+def read_symbols(elf, names):
+    """Returns {function: (address, size)} for the named functions."""
+    if shutil.which(NM) is None:
+        sys.exit(NM + ' not found, add the Teensy toolchain bin folder to PATH')
+    out = subprocess.run([NM, '-S', '-C', '--defined-only', elf], stdout=subprocess.PIPE,
+                         universal_newlines=True, check=True).stdout
+    syms = {}
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) < 4 or parts[2] not in 'tT':
+            continue
+        name = parts[3].split('(')[0]
+        if name in names:
+            syms[name] = (int(parts[0], 16), int(parts[1], 16))
+    return syms
+
+
+def place(funcs, syms, budget):
+    """Greedy by self cycles per byte.  Returns the set of functions to make HOT."""
+    ranked = sorted((f for f in funcs if f in syms and funcs[f][1] > 0),
+                    key=lambda f: funcs[f][1] / max(syms[f][1], 1), reverse=True)
+    hot, used = set(), 0
+    for f in ranked:
+        size = syms[f][1]
+        if used + size <= budget:
+            hot.add(f)
+            used += size
+    return hot
+
+
+def write_header(path, head, funcs, hot, budget):
+    with open(path, 'w', newline='\n') as out:
+        out.write('#ifndef _PLACEMENT_H_\n#define _PLACEMENT_H_\n//\n//  Placement.h\n//\n')
+        out.write('//  RAM (HOT) or flash (COLD) for the functions counted by a PROFILE build, see Profile.h.\n')
+        out.write('//  Written by PythonApps/placement_gen.py from a profile.log, hand edits are lost on the next run.\n')
+        out.write('//  Profile %d, %d ms run, ITCM budget %d bytes.\n' % (head['report'], head['ms'], budget))
+        out.write('//\n')
+        out.write('#define PLACE(f)    PLACE_##f\n\n')
+        for f in funcs:
+            out.write(('#define PLACE_%-21s %s' % (f, 'HOT' if f in hot else 'COLD')).rstrip() + '\n')
+        out.write('\n#endif // _PLACEMENT_H_\n')
+
+
+def report(head, funcs, syms, hot, budget, penalty):
+    cps = head['mhz'] * 1000000.0           # cycles per second
+    secs = max(head['ms'], 1) / 1000.0
+    saved = 0.0
+    print('%-20s %8s %6s %10s %10s  %-5s -> %-4s' % ('function', 'calls', 'bytes', 'self_kcyc', 'cyc/byte', 'now', 'new'))
+    for f in sorted(funcs, key=lambda f: funcs[f][1], reverse=True):
+        calls, self_k = funcs[f][0], funcs[f][1]
+        if f not in syms:
+            print('%-20s %8d %6s %10d %10s  not in the ELF, left COLD' % (f, calls, '-', self_k, '-'))
+            continue
+        addr, size = syms[f]
+        now = 'ITCM' if addr < ITCM_END else 'flash'
+        new = 'ITCM' if f in hot else 'flash'
+        if now == 'flash' and new == 'ITCM':
+            saved += self_k * 1000.0 * penalty / 100
+        elif now == 'ITCM' and new == 'flash':
+            saved -= self_k * 1000.0 * penalty / (100 - penalty)
+        print('%-20s %8d %6d %10d %10.1f  %-5s -> %-4s' % (f, calls, size, self_k, self_k * 1000.0 / max(size, 1), now, new))
+    used = sum(syms[f][1] for f in hot)
+    print('\nITCM for profiled functions %d of %d budget bytes' % (used, budget))
+    print('Estimated flash wait savings at %d%% penalty: %.0f kcycles over the run, %.0f cycles/s, %.3f%% of the CPU'
+          % (penalty, saved / 1000, saved / secs, 100.0 * saved / secs / cps))
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description='Generate Placement.h from a decoder profile report')
+    ap.add_argument('elf')
+    ap.add_argument('profile')
+    ap.add_argument('-o', '--out', default='Placement.h')
+    ap.add_argument('--budget', type=int, help='ITCM bytes for the profiled functions')
+    ap.add_argument('--penalty', type=int, default=30, help='percent of flash self cycles assumed to be cache miss stalls')
+    args = ap.parse_args(argv[1:])
+    if not 0 <= args.penalty < 100:
+        sys.exit('--penalty must be 0 to 99')
+
+    with open(args.profile) as src:
+        head, funcs = parse_profile(src)
+    if not funcs:
+        sys.exit('no profile report found')
+
+    syms = read_symbols(args.elf, set(funcs))
+    budget = args.budget
+    if budget is None:
+        budget = head['itcm_size'] - head['itcm_code'] + sum(s for a, s in syms.values() if a < ITCM_END)
+    hot = place(funcs, syms, budget)
+    report(head, funcs, syms, hot, budget, args.penalty)
+    write_header(args.out, head, funcs, hot, budget)
+    print('Wrote', args.out)
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -34,7 +34,7 @@ OmniRig V1 RS-HFIQ compatible CAT control from an external PC.
 #define BANNER "ICOM CIV USB Decoder"  // Custom Startup Screen Text
 #define CALLSIGN  "K7MDL CN87xs"   // Personalized Startup Screen Text
 
-#define CIV_ADDR CIV_ADDR_705     // The CIV address to use.  The list below is form the CIVMasterLib.  You can enter a custom address or use a predefined name below.
+#define CIV_ADDR CIV_ADDR_705     // The CIV address to try first, and the one used when RADIO_DETECT is 0 or the radio never answers.  The list below is form the CIVMasterLib.  You can enter a custom address or use a predefined name below.
                                   // CIV_ADDR_7100   = 0x88; // (Default-)address of the IC7100
                                   // CIV_ADDR_7300   = 0x94; // (Default-)address of the IC7300
                                   // CIV_ADDR_9700   = 0xA2; // (Default-)address of the IC9700
@@ -45,12 +45,86 @@ OmniRig V1 RS-HFIQ compatible CAT control from an external PC.
                             // The decoder will only monitor for key parameters such as frequency and PTT in order to perform the
                             //  most basic band decoder and PTT breakout service.
                             // 0 = allow send CIV data to radio (poll).  This can be used if no PC is connected to the CAT serial channel,
-                            //  or when a future feature saves and restores radio params on Xvtr band changes.
+                            //  and is needed for saving and restoring radio params on Xvtr band changes (XVTR_PROFILE_FIELDS).
+                            //  Per band drive limits are only enforced with 0, with 1 they are skipped and PTT is not held for them.
 
 #define RESET_MEMORY 1      // 1 will write the compiled defaults database values into memory losing all saved data.  
                             // 0 for normal use, operational values will be saved to storage (SD card if used or or EEPROM if used)
                             // During dev this is usually enabled to deal with changes in data structures 
 
+#define HYDRATE_REPLY_MS 100 // Startup background refresh: time to wait for each radio reply before retrying
+#define HYDRATE_RETRIES  2   // Startup background refresh: retries per request before leaving that entry unconfirmed
+
+#define WATCHDOG_TIMEOUT_S   5   // USE_WATCHDOG: seconds without a complete main loop pass before reset.  0.5s resolution
+#define WATCHDOG_TRIGGER_S   3   // USE_WATCHDOG: outputs are forced safe this many seconds before the reset (at 2s here)
+#define WATCHDOG_SAFE_DECODE DECODE_GENERAL  // USE_WATCHDOG: band decode pattern driven on a watchdog fault.  PTT outputs always go to RX
+
+#define TX_TIMER_WARN_S      15  // TX timeout: warning on screen and encoder LEDs this many seconds before the forced unkey.  Limit is bandmem[].tx_limit
+#define TX_TIMER_POLL_MS    500  // TX timeout: how often to ask the radio for TX state.  Catches TX keyed by a CAT program through the passthrough
+#define TX_TIMER_FLASH_MS   250  // TX timeout: encoder LED flash rate during the warning and lockout
+
+#define DRIVE_POLL_MS      2000  // Drive limit: how often to read the radio RF power once confirmed.  Catches front panel and PC changes
+#define DRIVE_RETRY_MS      250  // Drive limit: read back interval while waiting for the first confirmation or after an alarm
+
+#define BAND_GUARD_SETTLE_MS 50  // Band change during TX: held until RX plus this long for the amp and antenna relays to drop out
+#define BAND_GUARD_OVERRIDE   0  // Band change during TX: 0 = wait for the operator to unkey.  1 = force RX, settle, then switch
+
+#define EVENT_LOG_FLUSH_MS 10000 // Event recorder: how often new events are appended to events.log on the SD card.  Held off while keyed
+#define EVENT_LOG_DUMP_KEY   'E' // Event recorder: send this character on the Debug USB serial port to dump the ring
+
+#define MEM_CHECK_MS       10000 // Memory telemetry: how often the stack high-water mark and heap are measured
+#define MEM_STACK_MIN_FREE  8192 // Memory telemetry: warn on the Debug port when the stack high-water leaves less than this many bytes
+#define MEM_REPORT_KEY       'M' // Memory telemetry: send this character on the Debug USB serial port for the full report
+
+#define WC_FREQ_SPACING_MS    30 // Write combining: least time between VFO frequency writes.  Knob steps in between are merged, the last always goes
+#define WC_RIT_SPACING_MS     50 // Write combining: least time between RIT/XIT offset writes
+
+#define FREQ_SEP_KHZ         '.' // Frequency display: character between the MHz and kHz digits.  0 = none
+#define FREQ_SEP_HZ          '.' // Frequency display: character between the kHz and Hz digits.  0 = none
+#define FREQ_RESOLUTION        0 // Frequency display: Hz digits left off, 0-3.  1 shows 10Hz, 3 shows kHz
+#define FREQ_CHECK_KEY       'F' // Frequency codec: send this character on the Debug USB serial port to check and time it
+
+#define PROFILE_REPORT_KEY   'P' // PROFILE builds: send this character on the Debug USB serial port for the call and cycle counts
+
+#define RADIO_DETECT           1 // Radio models: 1 = ask the radio for its ID at connect and use that model's capabilities.  0 = always CIV_ADDR's model
+#define RADIO_DETECT_MS      100 // Radio models: time to wait for an ID reply before asking the next address
+#define RADIO_LISTEN_MS     2000 // Radio models: with NO_SEND 1 nothing is asked, listen this long at each address for a frame from the radio
+#define RADIO_DETECT_ROUNDS    3 // Radio models: passes over the known addresses before keeping the address in use, CIV_ADDR at boot
+#define RADIO_MODEL_KEY      'R' // Radio models: send this character on the Debug USB serial port to switch to the next model in the table
+
+#define LINK_LOST_MS        3000 // Link monitor: no valid CI-V frame from the radio for this long and the link is lost
+#define LINK_QUIET_MS      30000 // Link monitor: with NO_SEND 1 nothing can be asked, no frame for this long is a loss.  An idle radio is quiet
+#define LINK_PROBE_MS       1000 // Link monitor: quiet this long and an ID query checks the radio is still there.  While lost, detection restarts at this rate
+#define LINK_SAFE_OUTPUTS      1 // Link monitor: on loss 0 = leave the outputs, 1 = PTT outputs to RX and held there, 2 = also LINK_SAFE_DECODE on the band decode pins
+#define LINK_SAFE_DECODE DECODE_GENERAL // Link monitor: band decode pattern while the link is lost, LINK_SAFE_OUTPUTS 2 only
+#define LINK_DROP_KEY        'L' // Link monitor: send this character on the Debug USB serial port to drop the CI-V link, again to restore it
+
+#define XCV_CHECK_MS        2000 // Frequency tracking: no frequency frame for this long and one read checks that no transceive report was missed
+#define XCV_POLL_FAST_MS     100 // Frequency tracking: read interval with Transceive off in the radio, while the VFO is moving
+#define XCV_POLL_SLOW_MS    1000 // Frequency tracking: read interval with Transceive off, VFO idle.  The mode is read at this rate too
+#define XCV_MOVING_MS       2000 // Frequency tracking: the VFO counts as moving this long after a frequency change
+#define XCV_DROP_KEY         'X' // Frequency tracking: send this character on the Debug USB serial port to ignore transceive reports, again to take them
+
+#define CIV_FAULT_KEY        'J' // Fault injection: send this character on the Debug USB serial port to start a CI-V fault soak, again to stop it.  Bench only
+#define CIV_FAULT_SEED         1 // Fault injection: generator seed for round 0, round n uses seed + n
+#define CIV_FAULT_RUN_S       30 // Fault injection: seconds of faults per round, then the radio state is fetched again and checked
+#define CIV_FAULT_SETTLE_MS 3000 // Fault injection: least time after the faults stop before the check
+#define CIV_FAULT_DROP         5 // Fault injection: percent of frames lost
+#define CIV_FAULT_FLIP         2 // Fault injection: percent of frames with one bit flipped
+#define CIV_FAULT_DUP          2 // Fault injection: percent of frames delivered twice
+#define CIV_FAULT_REORDER      2 // Fault injection: percent of frames swapped with the next one
+#define CIV_FAULT_DELAY        3 // Fault injection: percent of frames held CIV_FAULT_DELAY_MS
+#define CIV_FAULT_DELAY_MS   150
+#define CIV_FAULT_JAM          1 // Fault injection: percent of frames starting a collision run of CIV_FAULT_JAM_FRAMES
+#define CIV_FAULT_JAM_FRAMES   3
+#define CIV_FAULT_BURST        1 // Fault injection: percent of frames starting a latency burst, every frame held to the end of CIV_FAULT_BURST_MS
+#define CIV_FAULT_BURST_MS   400
+
+#define XVTR_PROFILE_FIELDS 0x3F // Transverter bands: radio settings saved on band exit and restored on entry.  0 = off.  Needs NO_SEND 0
+                                 //   0x01 RF power, 0x02 RF gain, 0x04 NB, 0x08 NB level, 0x10 NR, 0x20 NR level
+#define XVTR_PROFILE_KEY     'V' // Transverter bands: send this character on the Debug USB serial port to show the current band's saved profile
+#define XVTR_CLEAR_KEY       'C' // Transverter bands: send this character on the Debug USB serial port to forget the current band's saved profile
+
                             // IC-905 CIV stuff
 #define GPS                 // Pass through USB Serial ch 'B' data   
 
@@ -69,13 +143,21 @@ OmniRig V1 RS-HFIQ compatible CAT control from an external PC.
                             // To enable touch by uncommenting this config item
                             //   #define USE_FT5206_TOUCH//capacitive touch screen
             
-//#define PE4302            // PE4302 Digital step attenuator. 31.5dB in 0.5 steps, only using 1dB steps today
+//#define PE4302            // PE4302 Digital step attenuator. 31.5dB in 0.5 steps.  Per band setting is bandmem[].step_atten
                             // Harmless to leave this defined as long as it is not connected via an I2C port expander
                             // DEPENDS on a PE4302 connected for variable attenuation
                             // MAY DEPEND on the Attenuation relay on a SV1AFN BPF board being turned on.
                             // You can use this without relays or the BPF board 
                             // The RF attenuator bypass relay is turned on and off.  Does not matter if there is a real relay connected or not. 
 
+//#define USE_WATCHDOG      // Hardware watchdog.  If the main loop stops checking in, PTT and band decode outputs go to a safe state, then reset.
+                            // DEPENDS on the Watchdog_t4 library by tonton81 https://github.com/tonton81/WDT_T4
+                            // Left off if the library is not installed.
+                            // Comment out while single stepping in a debugger.
+
+//#define PROFILE           // Count calls and cycles in the functions listed in Profile.h.  Feed the report to PythonApps/placement_gen.py
+                            // to regenerate Placement.h.  Adds a few cycles to every profiled call, leave off for normal use.
+
 //#define HARDWARE_ATT_SIZE  0   // Fixed attenuator size. 0 is OFF.  >0 == ON.   MAX = 99 (Future use!)
                             // This is used to correct the dBm scale on the spectrum 
                             // Can also fudge it to calibrate the spectrum until a more elegant solution is built
@@ -532,6 +614,22 @@ OmniRig V1 RS-HFIQ compatible CAT control from an external PC.
 #define BAND_DECODE_PTT_OUTPUT_PIN_6    GPIO_PIN_NOT_USED   // bit 6
 #define BAND_DECODE_PTT_OUTPUT_PIN_7    GPIO_PIN_NOT_USED   // bit 7
 
+// INTERLOCK (FAULT) INPUT PINS
+// An active input blocks PTT, drops PTT_OUT1 and the band decode PTT outputs to RX and latches a fault on screen.
+// The latch clears when XMIT is pressed with every input back to normal.  Inputs are sampled every 1ms in an interrupt.
+// _LEVEL is the pin level that means fault.  LOW gets the internal pullup, HIGH the pulldown.
+// _DEBOUNCE is how many ms the fault must hold before it counts.  Fault to RX time is _DEBOUNCE + 1ms at most.
+#define INTERLOCK_0_PIN                 GPIO_PIN_NOT_USED   // ex: amplifier fault
+#define INTERLOCK_0_LEVEL               LOW
+#define INTERLOCK_0_DEBOUNCE            2
+#define INTERLOCK_1_PIN                 GPIO_PIN_NOT_USED   // ex: high SWR
+#define INTERLOCK_1_LEVEL               LOW
+#define INTERLOCK_1_DEBOUNCE            2
+#define INTERLOCK_2_PIN                 GPIO_PIN_NOT_USED   // ex: sequencer not ready
+#define INTERLOCK_2_LEVEL               HIGH
+#define INTERLOCK_2_DEBOUNCE            5
+#define INTERLOCK_CIV_TX_OFF            1                   // 1 = also send TX off to the radio on a fault
+
 // Band Decode Output patterns.
 // By default using BCD pattern following the Elecraft K3 HF-TRN table.  5 bits are used. Bit 4 =1 is VHF+ group
 #define DECODE_BAND160M     (0x01)   //160M 
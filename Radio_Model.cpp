@@ -0,0 +1,217 @@
+//
+//  Radio_Model.cpp
+//
+//  Detection sends the ID query to the address in use first, CIV_ADDR at boot, then to each factory address in the
+//  table, RADIO_DETECT_MS apart.  radio_addr follows the address being tried so check_CIV() hears the reply.  The ID
+//  byte in the reply picks the row, the address that answered stays in use, so a radio moved off its factory address
+//  still works when CIV_ADDR is set to it.  No answer after RADIO_DETECT_ROUNDS passes leaves the address and model
+//  that were in use before.
+//  With NO_SEND 1 nothing is asked.  Each address is listened to for RADIO_LISTEN_MS instead, and the first valid
+//  frame from it picks the model whose factory address it is, or keeps the model in use at the address tried first.
+//  fe_top_band is BAND1296 on every row, the rule from before the table.  It is tested against the band in use, so a
+//  transverter band above 1296 has no preamp or attenuator even when its IF radio has them.
+//  Band stack codes and mode lists are from the Icom CI-V reference for each model.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Mode_Map.h"
+#include "Hydrate.h"
+#include "Xvtr.h"
+#include "Radio_Model.h"
+#include "Link.h"
+#include "No_Heap.h"
+
+extern CIV civ;
+extern struct cmdList cmd_List[];
+extern struct Band_Memory bandmem[];
+extern struct User_Settings user_settings[];
+extern uint8_t user_Profile;
+extern uint8_t Check_radio(void);
+
+#define RM_HF_BANDS     (RM_BAND(BAND160M) | RM_BAND(BAND80M) | RM_BAND(BAND60M) | RM_BAND(BAND40M) | RM_BAND(BAND30M) | \
+                         RM_BAND(BAND20M) | RM_BAND(BAND17M) | RM_BAND(BAND15M) | RM_BAND(BAND12M) | RM_BAND(BAND10M) | RM_BAND(BAND6M))
+#define RM_HF_BSTACK    {0x01, BAND160M}, {0x02, BAND80M}, {0x03, BAND40M}, {0x04, BAND30M}, {0x05, BAND20M}, \
+                        {0x06, BAND17M}, {0x07, BAND15M}, {0x08, BAND12M}, {0x09, BAND10M}, {0x10, BAND6M}
+
+PROGMEM static const struct RM_BStack bstack_705[]  = {RM_HF_BSTACK, {0x13, BAND144}, {0x14, BAND432}};
+PROGMEM static const struct RM_BStack bstack_905[]  = {{0x01, BAND144}, {0x02, BAND432}, {0x03, BAND1296}, {0x04, BAND2400}, {0x05, BAND5760}, {0x06, BAND10G}};
+PROGMEM static const struct RM_BStack bstack_9700[] = {{0x01, BAND144}, {0x02, BAND432}, {0x03, BAND1296}};
+PROGMEM static const struct RM_BStack bstack_7300[] = {RM_HF_BSTACK};
+PROGMEM static const struct RM_BStack bstack_7100[] = {RM_HF_BSTACK, {0x11, BAND144}, {0x12, BAND432}};
+
+#define RM_BSTACK(t)    t, sizeof(t) / sizeof(t[0])
+
+PROGMEM static const struct Radio_Model radio_model[] = {
+    // id            name       freq  bands                                                                    fe_top_band  cmds                               utc_cmd             modes                     xcv                          band stack
+    {CIV_ADDR_705,  "IC-705",  5, RM_HF_BANDS | RM_BAND(BAND144) | RM_BAND(BAND432),                               BAND1296, RM_CMD_F26 | RM_CMD_GPS | RM_CMD_UTC, CIV_C_UTC_READ_705, RM_MODE_WFM | RM_MODE_DV, RM_XCV_FREQ | RM_XCV_MODE, RM_BSTACK(bstack_705)},
+    {CIV_ADDR_905,  "IC-905",  6, RM_BAND(BAND144) | RM_BAND(BAND432) | RM_BAND(BAND1296) | RM_BAND(BAND2400) |
+                                  RM_BAND(BAND5760) | RM_BAND(BAND10G),                                             BAND1296, RM_CMD_F26 | RM_CMD_GPS | RM_CMD_UTC, CIV_C_UTC_READ_905, RM_MODE_DV | RM_MODE_DD | RM_MODE_ATV, RM_XCV_FREQ | RM_XCV_MODE, RM_BSTACK(bstack_905)},
+    {CIV_ADDR_9700, "IC-9700", 5, RM_BAND(BAND144) | RM_BAND(BAND432) | RM_BAND(BAND1296),                          BAND1296, RM_CMD_F26,                         0,                  RM_MODE_DV | RM_MODE_DD,  RM_XCV_FREQ | RM_XCV_MODE, RM_BSTACK(bstack_9700)},
+    {CIV_ADDR_7300, "IC-7300", 5, RM_HF_BANDS,                                                                      BAND1296, RM_CMD_F26,                         0,                  0,                        RM_XCV_FREQ | RM_XCV_MODE, RM_BSTACK(bstack_7300)},
+    {CIV_ADDR_7100, "IC-7100", 5, RM_HF_BANDS | RM_BAND(BAND144) | RM_BAND(BAND432),                               BAND1296, 0,                                  0,                  RM_MODE_WFM | RM_MODE_DV, RM_XCV_FREQ | RM_XCV_MODE, RM_BSTACK(bstack_7100)},
+    {0,             "Icom",    5, RM_HF_BANDS | RM_BAND(BAND144) | RM_BAND(BAND432),                               BAND1296, 0,                                  0,                  0,                        RM_XCV_FREQ | RM_XCV_MODE, NULL, 0}     // last, anything else
+};
+
+#define RM_MODELS       (sizeof(radio_model) / sizeof(radio_model[0]))
+
+static_assert(sizeof(bstack_705) / sizeof(bstack_705[0]) <= RM_BSTACK_MAX, "RM_BSTACK_MAX is too small");
+
+uint8_t radio_addr = CIV_ADDR;
+
+static const struct Radio_Model *rm = &radio_model[RM_MODELS - 1];
+static bool     rm_detecting = false;
+static uint8_t  rm_first     = CIV_ADDR;    // radio_addr when detection started, tried first
+static uint8_t  rm_try       = 0;   // 0 = rm_first, then radio_model[rm_try - 1]
+static uint8_t  rm_rounds    = 0;
+static uint32_t rm_sent      = 0;
+
+// The row for an ID byte, the catch-all row if it is not one of ours
+static const struct Radio_Model * Radio_Model_Find(uint8_t id)
+{
+    for (uint8_t i = 0; i < RM_MODELS - 1; i++)
+        if (radio_model[i].id == id)
+            return &radio_model[i];
+    return &radio_model[RM_MODELS - 1];
+}
+
+// Bands switched on in the band map that neither the radio nor a transverter on one of its bands can reach
+static uint8_t Radio_Model_Check_Bands(void)
+{
+    uint8_t missing = 0;
+
+    for (uint8_t b = 0; b <= BAND122G; b++)
+    {
+        uint8_t rf_band = Xvtr_Active(b) ? bandmem[b].xvtr_IF : b;
+
+        if (!bandmem[b].bandmap_en || (rm->bands & RM_BAND(rf_band)))
+            continue;
+        if (!missing++)
+            DPRINTF("Radio_Model: No band or transverter IF for");
+        DPRINTF(" "); DPRINT(bandmem[b].band_name);
+    }
+    if (missing)
+        DPRINTLNF("");
+    return missing;
+}
+
+// Everything that depends on the model is rebuilt here, then the radio state is fetched again for it
+static void Radio_Model_Select(const struct Radio_Model *model, uint8_t addr, bool hydrate)
+{
+    rm           = model;
+    radio_addr   = addr;
+    rm_detecting = false;
+    DPRINTF("Radio_Model: "); DPRINT(rm->name); DPRINTF(" at address "); DPRINTLN(radio_addr, HEX);
+    Radio_Model_Check_Bands();
+    Mode_Map_Init();
+    if (hydrate)
+        Hydrate_Start();
+}
+
+COLD void Radio_Model_Init(void)
+{
+    rm         = Radio_Model_Find(CIV_ADDR);
+    radio_addr = CIV_ADDR;
+}
+
+COLD void Radio_Model_Detect(void)
+{
+    #if RADIO_DETECT
+        rm_first     = radio_addr;
+        rm_try       = 0;
+        rm_rounds    = 0;
+        rm_sent      = millis() - RADIO_DETECT_MS;
+        rm_detecting = true;
+        DPRINTLN(NO_SEND ? "Radio_Model_Detect: Listening for the radio" : "Radio_Model_Detect: Asking the radio for its ID");
+    #else
+        Radio_Model_Select(Radio_Model_Find(CIV_ADDR), CIV_ADDR, true);
+    #endif
+}
+
+bool Radio_Model_Busy(void)
+{
+    return rm_detecting;
+}
+
+PLACE(Radio_Model_Service) void Radio_Model_Service(void)
+{
+    PROF(Radio_Model_Service);
+    uint8_t addr;
+
+    if (!rm_detecting)
+        return;
+
+    Check_radio();      // an answer arrives through check_CIV() and Radio_Model_Found()
+    if (!rm_detecting || (millis() - rm_sent) < (NO_SEND ? RADIO_LISTEN_MS : RADIO_DETECT_MS))
+        return;
+    if (user_settings[user_Profile].xmit)   // stay off the bus while transmitting
+        return;
+
+    // the catch-all row has no address of its own, a factory address equal to rm_first was already tried
+    while (rm_try > 0 && rm_try <= RM_MODELS && (rm_try == RM_MODELS || radio_model[rm_try - 1].id == rm_first))
+        rm_try++;
+    if (rm_try > RM_MODELS)
+    {
+        rm_try = 0;
+        if (++rm_rounds >= RADIO_DETECT_ROUNDS)
+        {
+            DPRINTF("Radio_Model_Service: No ID reply, staying with "); DPRINTLN(rm->name);
+            Radio_Model_Select(rm, rm_first, !Link_Lost());     // nothing to fetch from a radio that is not there
+            return;
+        }
+    }
+    addr = rm_try ? radio_model[rm_try - 1].id : rm_first;
+    rm_try++;
+
+    radio_addr = addr;
+    if (!NO_SEND)
+        civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_TRX_ID].cmdData), CIV_D_NIX, CIV_wFast);
+    rm_sent = millis();
+}
+
+// Any valid frame from radio_addr.  Only used to detect with NO_SEND 1, the model ID bytes are their factory addresses.
+void Radio_Model_Frame(void)
+{
+    if (!NO_SEND || !rm_detecting)
+        return;
+    Radio_Model_Select(radio_addr == rm_first ? rm : Radio_Model_Find(radio_addr), radio_addr, true);
+}
+
+void Radio_Model_Found(uint8_t id)
+{
+    if (!rm_detecting)
+        return;     // a PC program asking for the ID, nothing has changed
+    Radio_Model_Select(Radio_Model_Find(id), radio_addr, true);
+}
+
+const struct Radio_Model * Radio_Model_Get(void)
+{
+    return rm;
+}
+
+HOT bool Radio_Model_Has(uint8_t cmd)
+{
+    return (rm->cmds & cmd) != 0;
+}
+
+HOT bool Radio_Model_Front_End(uint8_t band)
+{
+    return band <= rm->fe_top_band;
+}
+
+uint8_t Radio_Model_BStack_Band(uint8_t code)
+{
+    for (uint8_t i = 0; i < rm->bstack_num; i++)
+        if (rm->bstack[i].code == code)
+            return rm->bstack[i].band;
+    return BANDS;
+}
+
+// Steps through the table at each row's factory address.  The catch-all row keeps CIV_ADDR.
+COLD void Radio_Model_Next(void)
+{
+    const struct Radio_Model *model = &radio_model[((rm - radio_model) + 1) % RM_MODELS];
+
+    Radio_Model_Select(model, model->id ? model->id : (uint8_t) CIV_ADDR, true);
+}
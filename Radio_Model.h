@@ -0,0 +1,64 @@
+#ifndef _RADIO_MODEL_H_
+#define _RADIO_MODEL_H_
+//
+//  Radio_Model.h
+//
+//  What each supported radio can do, one table row per model: frequency width, native bands, the optional commands
+//  this program uses, the extra modes and band stack band codes.  The row in use is picked when the radio answers the
+//  CI-V ID query (19 00) at connect, so one build serves every model in the table.  Code that used to test CIV_ADDR
+//  against a model address asks the active row instead.
+//
+#include <Arduino.h>
+
+#define RM_BAND(b)          (1UL << (b))    // bit for a bandmem[] index in Radio_Model.bands
+#define RM_BSTACK_MAX       12      // band stack band codes per model
+
+// Radio_Model.cmds, optional commands the radio answers
+#define RM_CMD_F26          0x01    // 26 00 selected VFO mode, data and filter
+#define RM_CMD_GPS          0x02    // 23 00 position and time
+#define RM_CMD_UTC          0x04    // 1A 05 UTC offset read, cmd_List[] index in utc_cmd
+
+// Radio_Model.modes, modes beyond LSB, USB, AM, CW, RTTY and FM.  See mode_radio[] in Mode_Map.cpp
+#define RM_MODE_WFM         0x01
+#define RM_MODE_DV          0x02
+#define RM_MODE_DD          0x04
+#define RM_MODE_ATV         0x08
+
+// Radio_Model.xcv, reports the radio sends unasked when its CI-V Transceive setting is on
+#define RM_XCV_FREQ         0x01    // 00 frequency
+#define RM_XCV_MODE         0x02    // 01 mode and filter, no data flag
+
+struct RM_BStack {
+    uint8_t code;           // radio band stack band code as sent, BCD
+    uint8_t band;           // bandmem[] index
+};
+
+struct Radio_Model {
+    uint8_t  id;            // ID byte in the 19 00 reply, also the factory CI-V address.  0 = any other Icom
+    char     name[8];
+    uint8_t  freq_bytes;    // BCD bytes in frequency data
+    uint32_t bands;         // RM_BAND() bits, bands the radio covers without a transverter
+    uint8_t  fe_top_band;   // highest band with preamp and attenuator, BAND1296 on every row as before the table
+    uint8_t  cmds;          // RM_CMD_xxx
+    uint8_t  utc_cmd;       // cmd_List[] index, RM_CMD_UTC only
+    uint8_t  modes;         // RM_MODE_xxx
+    uint8_t  xcv;           // RM_XCV_xxx
+    const struct RM_BStack *bstack;
+    uint8_t  bstack_num;
+};
+
+extern uint8_t radio_addr;  // CI-V address of the radio in use, CIV_ADDR until detection finds it
+
+void Radio_Model_Init(void);                    // CIV_ADDR's model, before anything is sent
+void Radio_Model_Detect(void);                  // start the ID query, or pick CIV_ADDR's model with RADIO_DETECT 0.  Again after a link loss
+void Radio_Model_Service(void);                 // call every loop pass.  One ID query per RADIO_DETECT_MS while detecting, listens with NO_SEND 1
+void Radio_Model_Found(uint8_t id);             // check_CIV() on an ID reply from radio_addr
+void Radio_Model_Frame(void);                   // check_CIV() on every valid frame, detection with NO_SEND 1
+bool Radio_Model_Busy(void);
+const struct Radio_Model * Radio_Model_Get(void);
+bool Radio_Model_Has(uint8_t cmd);              // RM_CMD_xxx
+bool Radio_Model_Front_End(uint8_t band);       // preamp and attenuator on this band
+uint8_t Radio_Model_BStack_Band(uint8_t code);  // bandmem[] index for a band stack band code, BANDS if not known
+void Radio_Model_Next(void);                    // test hook, switch to the next table row as if that radio answered
+
+#endif // _RADIO_MODEL_H_
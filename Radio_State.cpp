@@ -0,0 +1,135 @@
+//
+//  Radio_State.cpp
+//
+//  A field is marked changed when the radio reports a value different from the one held, or reports back a value
+//  that was pending from RS_Request().  Requests themselves do not notify, the code sending them has already
+//  updated its own state.  Notifications are collected as a bit mask and delivered later from RS_Service().
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Radio_State.h"
+#include "No_Heap.h"
+
+static struct Radio_Value rs_model[RS_FIELDS];
+
+static struct {
+    uint32_t    mask;
+    RS_Listener fn;
+} rs_listeners[RS_LISTENERS_MAX];
+
+static uint8_t  rs_listener_count = 0;
+static uint32_t rs_changed        = 0;      // fields waiting for RS_Service()
+
+static const char * const rs_names[RS_FIELDS] = {
+    "Freq", "Mode", "Filter", "Data", "TX", "Preamp", "Attn", "AGC", "Split", "Duplex", "RIT", "RIT On", "XIT On", "RF Power"
+};
+
+void RS_Radio(uint8_t field, int64_t value)
+{
+    struct Radio_Value *v;
+
+    if (field >= RS_FIELDS)
+        return;
+    v = &rs_model[field];
+    if (v->value != value || v->source != RS_SRC_RADIO)
+        rs_changed |= RS_MASK(field);
+    v->value   = value;
+    v->source  = RS_SRC_RADIO;
+    v->updated = millis();
+}
+
+void RS_Request(uint8_t field, int64_t value)
+{
+    struct Radio_Value *v;
+
+    if (field >= RS_FIELDS)
+        return;
+    v = &rs_model[field];
+    v->value   = value;
+    v->source  = RS_SRC_PENDING;
+    v->updated = millis();
+}
+
+// No notification, the value is the one we sent
+void RS_Acked(uint8_t field)
+{
+    if (field < RS_FIELDS && rs_model[field].source == RS_SRC_PENDING)
+    {
+        rs_model[field].source  = RS_SRC_RADIO;
+        rs_model[field].updated = millis();
+    }
+}
+
+bool RS_Matches(uint8_t field, int64_t value)
+{
+    return field < RS_FIELDS && rs_model[field].source == RS_SRC_RADIO && rs_model[field].value == value;
+}
+
+int64_t RS_Get(uint8_t field)
+{
+    return (field < RS_FIELDS) ? rs_model[field].value : 0;
+}
+
+uint8_t RS_Source(uint8_t field)
+{
+    return (field < RS_FIELDS) ? rs_model[field].source : (uint8_t) RS_SRC_NONE;
+}
+
+uint32_t RS_Age(uint8_t field)
+{
+    if (field >= RS_FIELDS || rs_model[field].source == RS_SRC_NONE)
+        return 0xFFFFFFFF;
+    return millis() - rs_model[field].updated;
+}
+
+COLD bool RS_Subscribe(uint32_t mask, RS_Listener fn)
+{
+    if (rs_listener_count >= RS_LISTENERS_MAX || fn == NULL)
+    {
+        DPRINTLNF("RS_Subscribe: No room for another listener");
+        return false;
+    }
+    rs_listeners[rs_listener_count].mask = mask;
+    rs_listeners[rs_listener_count].fn   = fn;
+    rs_listener_count++;
+    return true;
+}
+
+// A listener may call RS_Request() or trigger more RS_Radio() calls, those land in the next pass.
+PLACE(RS_Service) void RS_Service(void)
+{
+    PROF(RS_Service);
+    uint32_t changed;
+
+    if (!rs_changed)
+        return;
+    changed    = rs_changed;
+    rs_changed = 0;
+
+    for (uint8_t f = 0; f < RS_FIELDS; f++)
+    {
+        if (!(changed & RS_MASK(f)))
+            continue;
+        for (uint8_t i = 0; i < rs_listener_count; i++)
+            if (rs_listeners[i].mask & RS_MASK(f))
+                rs_listeners[i].fn(f, rs_model[f].value);
+    }
+}
+
+COLD void RS_Show(void)
+{
+    static const char * const src_names[] = { "none", "pending", "radio" };
+
+    DPRINTLNF("RS_Show: Radio state model");
+    for (uint8_t f = 0; f < RS_FIELDS; f++)
+    {
+        DPRINTF("  "); DPRINT(rs_names[f]); DPRINTF(" = "); DPRINT(rs_model[f].value);
+        DPRINTF("  "); DPRINT(src_names[rs_model[f].source]);
+        if (rs_model[f].source != RS_SRC_NONE)
+        {
+            DPRINTF(" "); DPRINT(RS_Age(f)); DPRINTF("ms ago");
+        }
+        DPRINTLNF("");
+    }
+}
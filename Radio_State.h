@@ -0,0 +1,59 @@
+#ifndef _RADIO_STATE_H_
+#define _RADIO_STATE_H_
+//
+//  Radio_State.h
+//
+//  Shadow model of the radio.  Holds every value the CI-V layer decodes with where it came from and when.
+//  check_CIV() only writes here.  Display, band memory and outputs subscribe and are told about changes from the
+//  main loop, so the parser never draws on the screen.
+//
+#include <Arduino.h>
+
+enum Radio_Field {
+    RS_FREQ,                // radio dial frequency in Hz.  This is the IF on a transverter band
+    RS_MODE,                // modeList[] index
+    RS_FILTER,              // radio filter 1-3
+    RS_DATA,                // DATA mode on/off
+    RS_TX,                  // 1 = transmitting
+    RS_PREAMP,              // 0 off, >0 on
+    RS_ATTN,                // 0 off, >0 on
+    RS_AGC,                 // AGC_FAST, AGC_MID, AGC_SLOW
+    RS_SPLIT,
+    RS_DUPLEX,              // duplex offset in Hz
+    RS_RIT,                 // RIT/XIT offset in Hz
+    RS_RIT_ON,
+    RS_XIT_ON,
+    RS_RF_POWER,            // RF power level 0-255
+    RS_FIELDS
+};
+
+enum Radio_Source {
+    RS_SRC_NONE,            // never set this session
+    RS_SRC_PENDING,         // we sent it, the radio has not reported it back yet
+    RS_SRC_RADIO            // reported by the radio
+};
+
+#define RS_MASK(f)          (1UL << (f))
+#define RS_LISTENERS_MAX    6
+
+struct Radio_Value {
+    int64_t  value;
+    uint32_t updated;       // millis() of the last set or request
+    uint8_t  source;        // Radio_Source
+};
+
+// Called from RS_Service() once per changed field
+typedef void (*RS_Listener)(uint8_t field, int64_t value);
+
+void     RS_Radio(uint8_t field, int64_t value);    // value reported by the radio
+void     RS_Request(uint8_t field, int64_t value);  // value we just sent to the radio, pending until it reports back
+void     RS_Acked(uint8_t field);                   // the radio answered OK to the write, the pending value is now its value
+bool     RS_Matches(uint8_t field, int64_t value);  // true if the radio is known to hold value
+int64_t  RS_Get(uint8_t field);
+uint8_t  RS_Source(uint8_t field);
+uint32_t RS_Age(uint8_t field);                     // ms since last set, 0xFFFFFFFF if never
+bool     RS_Subscribe(uint32_t mask, RS_Listener fn);
+void     RS_Service(void);                          // deliver change notifications, call every loop pass
+void     RS_Show(void);                             // debug dump of the model
+
+#endif // _RADIO_STATE_H_
@@ -0,0 +1,118 @@
+//
+//  Radio_Sync.cpp
+//
+//  Replaces the unconditional pushes in changeBands().  Each setting is first put through its display-only path
+//  (toggle or dir 3) which applies the usual limits to bandmem[] and updates the screen.  The result is compared with
+//  the radio state model and the setter that writes to the radio is only called when they differ or the radio
+//  value is not known.
+//  Write order follows the radio's dependencies:
+//    Mode, filter and DATA first, in one frame.  The mode decides what AGC and filter settings are allowed.
+//    Preamp and attenuator next.  The radio allows only one on, so the one turning off goes first.
+//    AGC last, digital modes hold it at FAST.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Controls.h"
+#include "Radio_State.h"
+#include "Radio_Sync.h"
+#include "Radio_Model.h"
+#include "No_Heap.h"
+
+extern struct Band_Memory bandmem[];
+extern struct Modes_List modeList[];
+extern uint8_t curr_band;
+extern uint8_t Check_radio(void);
+
+static struct Radio_Sync_Stats sync_stats;
+
+// Preamp and attenuator report a level (attenuator in dB), we only track on and off
+static bool Sync_Known_On(uint8_t field, uint8_t on)
+{
+    return RS_Source(field) == RS_SRC_RADIO && (RS_Get(field) != 0) == (on != 0);
+}
+
+static uint8_t Sync_Mode(uint8_t band)
+{
+    uint8_t mndx = bandmem[band].mode_A;
+
+    setMode(3);     // screen only, applies the DD filter rule
+    modeList[mndx].Width = bandmem[band].filter_A;  // last used width on this band
+    if (RS_Matches(RS_MODE, mndx) && RS_Matches(RS_FILTER, bandmem[band].filter_A) && RS_Matches(RS_DATA, modeList[mndx].data))
+        return 0;
+    send_Mode_to_Radio(mndx);
+    return 1;
+}
+
+// Preamp and attenuator are not sent where the radio has none (IC905 above 1296), the setters skip them there
+static uint8_t Sync_Preamp(uint8_t band)
+{
+    Preamp(3);
+    if (!Radio_Model_Front_End(band) || Sync_Known_On(RS_PREAMP, bandmem[band].preamp))
+        return 0;
+    Preamp(-1);
+    Check_radio();  // service the rx buffer, we are not back in the main loop yet
+    return 1;
+}
+
+static uint8_t Sync_Attn(uint8_t band)
+{
+    setAttn(3);
+    if (!Radio_Model_Front_End(band) || Sync_Known_On(RS_ATTN, bandmem[band].attenuator))
+        return 0;
+    setAttn(-1);
+    Check_radio();
+    return 1;
+}
+
+// A mode change can move the radio to its per mode AGC so resend after one
+static uint8_t Sync_AGC(uint8_t band, uint8_t mode_sent)
+{
+    AGC(3);         // forces FAST for digital modes
+    if (AGC_Fast_Only(bandmem[band].mode_A))    // the radio is already in FAST, AGC() will not send
+        return 0;
+    if (!mode_sent && RS_Matches(RS_AGC, bandmem[band].agc_mode))
+        return 0;
+    AGC(2);
+    return 1;
+}
+
+// Call after curr_band and the band's bandmem[] entry are settled.  Sync complete is reported in the stats.
+COLD uint8_t Radio_Sync_Band(uint8_t band)
+{
+    uint8_t writes = 0;
+    uint8_t steps  = 0;
+    uint8_t mode_sent;
+
+    if (band != curr_band || band >= BANDS)
+        return 0;
+
+    mode_sent = Sync_Mode(band);
+    writes += mode_sent;        steps++;
+    if (bandmem[band].preamp == PREAMP_ON)
+    {
+        writes += Sync_Attn(band);   steps++;
+        writes += Sync_Preamp(band); steps++;
+    }
+    else
+    {
+        writes += Sync_Preamp(band); steps++;
+        writes += Sync_Attn(band);   steps++;
+    }
+    writes += Sync_AGC(band, mode_sent); steps++;
+
+    sync_stats.syncs++;
+    sync_stats.writes   += writes;
+    sync_stats.skipped  += steps - writes;
+    sync_stats.last_ms   = millis();
+    sync_stats.last_band = band;
+    DPRINTF("Radio_Sync_Band: "); DPRINT(bandmem[band].band_name); DPRINTF(" sync complete, "); DPRINT(writes);
+    DPRINTF(" writes, "); DPRINT(steps - writes); DPRINTF(" skipped.  Totals "); DPRINT(sync_stats.writes);
+    DPRINTF(" writes "); DPRINT(sync_stats.skipped); DPRINTLNF(" skipped");
+    return writes;
+}
+
+const struct Radio_Sync_Stats * Radio_Sync_Get_Stats(void)
+{
+    return &sync_stats;
+}
@@ -0,0 +1,22 @@
+#ifndef _RADIO_SYNC_H_
+#define _RADIO_SYNC_H_
+//
+//  Radio_Sync.h
+//
+//  Band entry reconciliation.  Compares the band's settings in bandmem[] with what the radio is known to hold in
+//  the Radio_State model and sends only the settings that differ.
+//
+#include <Arduino.h>
+
+struct Radio_Sync_Stats {
+    uint32_t syncs;         // band entries reconciled
+    uint32_t writes;        // CI-V setting writes sent
+    uint32_t skipped;       // writes not needed, the radio already had the value
+    uint32_t last_ms;       // millis() when the last sync completed
+    uint8_t  last_band;
+};
+
+uint8_t Radio_Sync_Band(uint8_t band);              // returns the number of writes sent
+const struct Radio_Sync_Stats * Radio_Sync_Get_Stats(void);
+
+#endif // _RADIO_SYNC_H_
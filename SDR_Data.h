@@ -19,34 +19,69 @@
 //
 
 struct Band_Memory bandmem[BANDS] = {
-    // name         lower     upper         VFOA    Md_A filtA  dataA          VFOA-1  mode1 filt1  data 1        VFOA-2    mode2 filt2  data2            VFOB   modeB filt  varfil bandnum   ts agc    SPLIT RT  XT ATU ANT   BPF ATTN   AttByp att_DB   PREAMP   SSPL  bmap  XV#     Xvtr_IF  dirty XPwr DialCal Decode
-    {"160M",     1800000,     2000000,     1840000, USB, FILT2, DATA_OFF,      1860000, LSB, FILT1, DATA_OFF,      1910000,  LSB, FILT1, DATA_OFF,      1860000, LSB, BW3_2, 3200,  BAND160M, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 0,  ATTN_OFF,  0,   20,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,    0,  0xFFFF},
-    { "80M",     3500000,     4000000,     3573000, USB, FILT1, DATA_OFF,      3868000, LSB, FILT1, DATA_OFF,      3813000,  LSB, FILT1, DATA_OFF,      3868000, LSB, BW3_2, 3200,  BAND80M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 1,  ATTN_OFF,  0,   20,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF},
-    { "60M",     4990000,     5405000,     5000000, AM,  FILT1, DATA_OFF,      5287200, LSB, FILT1, DATA_OFF,      5364700,  LSB, FILT1, DATA_OFF,      5405000, USB, BW6_0, 6000,  BAND60M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 2,  ATTN_OFF,  0,   10,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF},
-    { "40M",     7000000,     7300000,     7074000, USB, FILT1, DATA_OFF,      7030000, CW,  FILT2, DATA_OFF,      7200000,  LSB, FILT1, DATA_OFF,      7200000, LSB, BW3_2, 3200,  BAND40M,  3, AGC_SLOW,OFF,OFF,OFF,OFF,ANT2, 3,  ATTN_OFF,  0,   10,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF},
-    { "30M",     9990000,    10150000,    10000000, AM,  FILT1, DATA_OFF,     10136000, USB, FILT1, DATA_OFF,     10130000,  CW,  FILT2, DATA_OFF,     10136000, USB, BW6_0, 6000,  BAND30M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 4,  ATTN_OFF,  0,   10,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF},
-    { "20M",    14000000,    14350000,    14074000, USB, FILT1, DATA_OFF,     14030000, CW,  FILT1, DATA_OFF,     14200000,  USB, FILT1, DATA_OFF,     14200000, USB, BW4_0, 4000,  BAND20M,  3, AGC_SLOW,OFF,OFF,OFF,OFF,ANT2, 5,  ATTN_OFF,  0,   10,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF},
-    { "17M",    18068000,    18168000,    18100000, USB, FILT1, DATA_OFF,     18135000, USB, FILT1, DATA_OFF,     18090000,  CW,  FILT2, DATA_OFF,     18135000, USB, BW3_2, 3200,  BAND17M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 6,  ATTN_ON,   1,   14,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF},
-    { "15M",    21000000,    21450000,    21074000, USB, FILT1, DATA_OFF,     21030000, CW,  FILT1, DATA_OFF,     21300000,  USB, FILT1, DATA_OFF,     21350000, USB, BW3_2, 3200,  BAND15M,  3, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 7,  ATTN_ON,   1,    3,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF},
-    { "12M",    24890000,    24990000,    24915000, USB, FILT1, DATA_OFF,     24892000, CW,  FILT1, DATA_OFF,     24950000,  USB, FILT1, DATA_OFF,     24904000, USB, BW3_2, 3200,  BAND12M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 8,  ATTN_ON,   1,    3,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF},
-    { "10M",    28000000,    29600000,    28074000, USB, FILT1, DATA_OFF,     28200000, USB, FILT1, DATA_OFF,     29400000,  USB, FILT2, DATA_OFF,     28200000, USB, BW4_0, 4000,  BAND10M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 9,  ATTN_OFF,  0,    0,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF},
-    {  "6M",    50000000,    54000000,    50125000, USB, FILT1, DATA_OFF,     50313000, USB, FILT1, DATA_OFF,     50100000,  CW,  FILT2, DATA_OFF,     50313000, USB, BW3_2, 3200,  BAND6M,   1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 30,    -0,  0x0001},
-    { "144",   144000000,   148000000,   144200000, USB, FILT2, DATA_OFF,    144200000, USB, FILT1, DATA_OFF,    144200000,  CW,  FILT1, DATA_OFF,    144200000, USB, BW3_2, 3200,  BAND144,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_ON,   1,    3,  PREAMP_ON,   5,  ON,   NONE,    NONE,     0, 10,    -0,  0x0002},
-    { "222",   222000000,   225000000,   222100000, USB, FILT2, DATA_OFF,    222100000, USB, FILT1, DATA_OFF,    222100000,  CW,  FILT1, DATA_OFF,    222100000, USB, BW3_2, 3200,  BAND222,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR1,   BAND10M,  0, 10,   -10,  0x0004},
-    { "432",   430000000,   450000000,   432100000, USB, FILT2, DATA_OFF,    432100000, USB, FILT1, DATA_OFF,    432100000,  CW,  FILT1, DATA_OFF,    432100000, USB, BW3_2, 3200,  BAND432,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   NONE,    NONE,     0, 40,   -10,  0x0008},
-    { "903",   902000000,   904000000,   903100000, USB, FILT2, DATA_OFF,    903100000, USB, FILT1, DATA_OFF,    903100000,  CW,  FILT2, DATA_OFF,    903100000, USB, BW3_2, 3200,  BAND902,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR2,   BAND10M,  0, 60,   -10,  0x0010},
-    {"1296",  1296000000,  1298000000,  1296100000, USB, FILT2, DATA_OFF,   1296074000, USB, FILT1, DATA_OFF,   1296110000,  CW,  FILT2, DATA_OFF,   1296120000, USB, BW3_2, 3200,  BAND1296, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   XVTR3,   BAND10M,  0, 54,   -10,  0x0020},
-    {"2400",  2304000000,  2402000000,  2304100000, USB, FILT1, DATA_OFF,   2304100000, USB, FILT1, DATA_OFF,   2304100000,  CW,  FILT2, DATA_OFF,   2304100000, USB, BW3_2, 3200,  BAND2400, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   NONE,    BAND432,  0, 70,   -10,  0x0040},
-    {"3400",  3400000000,  3402000000,  3400100000, USB, FILT1, DATA_OFF,   3400100000, USB, FILT1, DATA_OFF,   3400100000,  CW,  FILT2, DATA_OFF,   3400100000, USB, BW3_2, 3200,  BAND3400, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR9,   BAND144,  0, 80,   -10,  0x001F},
-    {"5760",  5760000000,  5925000000,  5760100000, USB, FILT1, DATA_OFF,   5912100000, USB, FILT1, DATA_OFF,   5760100000,  CW,  FILT2, DATA_OFF,   5760100000, USB, BW3_2, 3200,  BAND5760, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   NONE,    BAND432,  0, 14,   -10,  0x002F},
-    { "10G", 10000000000, 10500000000, 10368100000, USB, FILT1, DATA_OFF,  10368100000, USB, FILT1, DATA_OFF,  10368100000,  CW,  FILT2, DATA_OFF,  10368100000, USB, BW3_2, 3200,  BAND10G,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   NONE,    BAND432,  0, 24,   -10,  0x10F1},
-    { "24G", 24048000000, 24050000000, 24048200000, USB, FILT1, DATA_OFF,  24192100000, USB, FILT1, DATA_OFF,  24192100000,  CW,  FILT2, DATA_OFF,  24192100000, USB, BW3_2, 3200,  BAND24G,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR12,  BAND10M,  0, 45,   -10,  0x00F2},
-    {" 47G", 47000000000, 47002000000, 47000100000, USB, FILT1, DATA_OFF,  47000100000, USB, FILT1, DATA_OFF,  47000100000,  CW,  FILT2, DATA_OFF,  47000100000, USB, BW3_2, 3200,  BAND47G,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR13,  BAND10M,  0, 10,   -10,  0x00FF},
-    {" 76G", 76000000000, 76002000000, 76000100000, USB, FILT1, DATA_OFF,  76000100000, USB, FILT1, DATA_OFF,  76000100000,  CW,  FILT2, DATA_OFF,  76000100000, USB, BW3_2, 3200,  BAND76G,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR14,  BAND10M,  0, 10,   -10,  0x00FF},
-    {"122G",122000000000,122002000000,122000100000, USB, FILT1, DATA_OFF, 122000100000, USB, FILT1, DATA_OFF, 122000100000,  CW,  FILT2, DATA_OFF, 122000100000, USB, BW3_2, 3200,  BAND122G, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR15,  BAND432,  0, 10,   -10,  0x00FF},
-    { "PAN",     8200000,     8300000,     8215000, USB, FILT1, DATA_OFF,      8215000, USB, FILT2, DATA_OFF,      8215000,  USB, FILT2, DATA_OFF,      8215000, LSB, BW2_8, 2800,  PAN_ADAPT,1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 0,  ATTN_OFF,  0,   50,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0,  2,   -10,  0x00FF}
+    // name         lower     upper         VFOA    Md_A filtA  dataA          VFOA-1  mode1 filt1  data 1        VFOA-2    mode2 filt2  data2            VFOB   modeB filt  varfil bandnum   ts agc    SPLIT RT  XT ATU ANT   BPF ATTN   AttByp att_DB   PREAMP   SSPL  bmap  XV#     Xvtr_IF  dirty XPwr DialCal Decode  StpAtt TxLim DrvLim
+    {"160M",     1800000,     2000000,     1840000, USB, FILT2, DATA_OFF,      1860000, LSB, FILT1, DATA_OFF,      1910000,  LSB, FILT1, DATA_OFF,      1860000, LSB, BW3_2, 3200,  BAND160M, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 0,  ATTN_OFF,  0,   20,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,    0,  0xFFFF,   0,  180,  255},
+    { "80M",     3500000,     4000000,     3573000, USB, FILT1, DATA_OFF,      3868000, LSB, FILT1, DATA_OFF,      3813000,  LSB, FILT1, DATA_OFF,      3868000, LSB, BW3_2, 3200,  BAND80M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 1,  ATTN_OFF,  0,   20,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF,   0,  180,  255},
+    { "60M",     4990000,     5405000,     5000000, AM,  FILT1, DATA_OFF,      5287200, LSB, FILT1, DATA_OFF,      5364700,  LSB, FILT1, DATA_OFF,      5405000, USB, BW6_0, 6000,  BAND60M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 2,  ATTN_OFF,  0,   10,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF,   0,  180,  255},
+    { "40M",     7000000,     7300000,     7074000, USB, FILT1, DATA_OFF,      7030000, CW,  FILT2, DATA_OFF,      7200000,  LSB, FILT1, DATA_OFF,      7200000, LSB, BW3_2, 3200,  BAND40M,  3, AGC_SLOW,OFF,OFF,OFF,OFF,ANT2, 3,  ATTN_OFF,  0,   10,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF,   0,  180,  255},
+    { "30M",     9990000,    10150000,    10000000, AM,  FILT1, DATA_OFF,     10136000, USB, FILT1, DATA_OFF,     10130000,  CW,  FILT2, DATA_OFF,     10136000, USB, BW6_0, 6000,  BAND30M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 4,  ATTN_OFF,  0,   10,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF,   0,  180,  255},
+    { "20M",    14000000,    14350000,    14074000, USB, FILT1, DATA_OFF,     14030000, CW,  FILT1, DATA_OFF,     14200000,  USB, FILT1, DATA_OFF,     14200000, USB, BW4_0, 4000,  BAND20M,  3, AGC_SLOW,OFF,OFF,OFF,OFF,ANT2, 5,  ATTN_OFF,  0,   10,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF,   0,  180,  255},
+    { "17M",    18068000,    18168000,    18100000, USB, FILT1, DATA_OFF,     18135000, USB, FILT1, DATA_OFF,     18090000,  CW,  FILT2, DATA_OFF,     18135000, USB, BW3_2, 3200,  BAND17M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 6,  ATTN_ON,   1,   14,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF,   0,  180,  255},
+    { "15M",    21000000,    21450000,    21074000, USB, FILT1, DATA_OFF,     21030000, CW,  FILT1, DATA_OFF,     21300000,  USB, FILT1, DATA_OFF,     21350000, USB, BW3_2, 3200,  BAND15M,  3, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 7,  ATTN_ON,   1,    3,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF,   0,  180,  255},
+    { "12M",    24890000,    24990000,    24915000, USB, FILT1, DATA_OFF,     24892000, CW,  FILT1, DATA_OFF,     24950000,  USB, FILT1, DATA_OFF,     24904000, USB, BW3_2, 3200,  BAND12M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 8,  ATTN_ON,   1,    3,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF,   0,  180,  255},
+    { "10M",    28000000,    29600000,    28074000, USB, FILT1, DATA_OFF,     28200000, USB, FILT1, DATA_OFF,     29400000,  USB, FILT2, DATA_OFF,     28200000, USB, BW4_0, 4000,  BAND10M,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 9,  ATTN_OFF,  0,    0,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 100,   -0,  0xFFFF,   0,  180,  255},
+    {  "6M",    50000000,    54000000,    50125000, USB, FILT1, DATA_OFF,     50313000, USB, FILT1, DATA_OFF,     50100000,  CW,  FILT2, DATA_OFF,     50313000, USB, BW3_2, 3200,  BAND6M,   1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_ON,   5,  OFF,  NONE,    NONE,     0, 30,    -0,  0x0001,   0,  180,  255},
+    { "144",   144000000,   148000000,   144200000, USB, FILT2, DATA_OFF,    144200000, USB, FILT1, DATA_OFF,    144200000,  CW,  FILT1, DATA_OFF,    144200000, USB, BW3_2, 3200,  BAND144,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_ON,   1,    3,  PREAMP_ON,   5,  ON,   NONE,    NONE,     0, 10,    -0,  0x0002,   0,  180,  255},
+    { "222",   222000000,   225000000,   222100000, USB, FILT2, DATA_OFF,    222100000, USB, FILT1, DATA_OFF,    222100000,  CW,  FILT1, DATA_OFF,    222100000, USB, BW3_2, 3200,  BAND222,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR1,   BAND10M,  0, 10,   -10,  0x0004,   0,  180,  255},
+    { "432",   430000000,   450000000,   432100000, USB, FILT2, DATA_OFF,    432100000, USB, FILT1, DATA_OFF,    432100000,  CW,  FILT1, DATA_OFF,    432100000, USB, BW3_2, 3200,  BAND432,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   NONE,    NONE,     0, 40,   -10,  0x0008,   0,  180,  255},
+    { "903",   902000000,   904000000,   903100000, USB, FILT2, DATA_OFF,    903100000, USB, FILT1, DATA_OFF,    903100000,  CW,  FILT2, DATA_OFF,    903100000, USB, BW3_2, 3200,  BAND902,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR2,   BAND10M,  0, 60,   -10,  0x0010,   0,  180,  255},
+    {"1296",  1296000000,  1298000000,  1296100000, USB, FILT2, DATA_OFF,   1296074000, USB, FILT1, DATA_OFF,   1296110000,  CW,  FILT2, DATA_OFF,   1296120000, USB, BW3_2, 3200,  BAND1296, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   XVTR3,   BAND10M,  0, 54,   -10,  0x0020,   0,  180,  255},
+    {"2400",  2304000000,  2402000000,  2304100000, USB, FILT1, DATA_OFF,   2304100000, USB, FILT1, DATA_OFF,   2304100000,  CW,  FILT2, DATA_OFF,   2304100000, USB, BW3_2, 3200,  BAND2400, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   NONE,    BAND432,  0, 70,   -10,  0x0040,   0,  180,  255},
+    {"3400",  3400000000,  3402000000,  3400100000, USB, FILT1, DATA_OFF,   3400100000, USB, FILT1, DATA_OFF,   3400100000,  CW,  FILT2, DATA_OFF,   3400100000, USB, BW3_2, 3200,  BAND3400, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR9,   BAND144,  0, 80,   -10,  0x001F,   0,  180,  255},
+    {"5760",  5760000000,  5925000000,  5760100000, USB, FILT1, DATA_OFF,   5912100000, USB, FILT1, DATA_OFF,   5760100000,  CW,  FILT2, DATA_OFF,   5760100000, USB, BW3_2, 3200,  BAND5760, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   NONE,    BAND432,  0, 14,   -10,  0x002F,   0,  180,  255},
+    { "10G", 10000000000, 10500000000, 10368100000, USB, FILT1, DATA_OFF,  10368100000, USB, FILT1, DATA_OFF,  10368100000,  CW,  FILT2, DATA_OFF,  10368100000, USB, BW3_2, 3200,  BAND10G,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  ON,   NONE,    BAND432,  0, 24,   -10,  0x10F1,   0,  180,  255},
+    { "24G", 24048000000, 24050000000, 24048200000, USB, FILT1, DATA_OFF,  24192100000, USB, FILT1, DATA_OFF,  24192100000,  CW,  FILT2, DATA_OFF,  24192100000, USB, BW3_2, 3200,  BAND24G,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR12,  BAND10M,  0, 45,   -10,  0x00F2,   0,  180,  255},
+    {" 47G", 47000000000, 47002000000, 47000100000, USB, FILT1, DATA_OFF,  47000100000, USB, FILT1, DATA_OFF,  47000100000,  CW,  FILT2, DATA_OFF,  47000100000, USB, BW3_2, 3200,  BAND47G,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR13,  BAND10M,  0, 10,   -10,  0x00FF,   0,  180,  255},
+    {" 76G", 76000000000, 76002000000, 76000100000, USB, FILT1, DATA_OFF,  76000100000, USB, FILT1, DATA_OFF,  76000100000,  CW,  FILT2, DATA_OFF,  76000100000, USB, BW3_2, 3200,  BAND76G,  1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR14,  BAND10M,  0, 10,   -10,  0x00FF,   0,  180,  255},
+    {"122G",122000000000,122002000000,122000100000, USB, FILT1, DATA_OFF, 122000100000, USB, FILT1, DATA_OFF, 122000100000,  CW,  FILT2, DATA_OFF, 122000100000, USB, BW3_2, 3200,  BAND122G, 1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1,10,  ATTN_OFF,  0,    0,  PREAMP_OFF,  5,  OFF,  XVTR15,  BAND432,  0, 10,   -10,  0x00FF,   0,  180,  255},
+    { "PAN",     8200000,     8300000,     8215000, USB, FILT1, DATA_OFF,      8215000, USB, FILT2, DATA_OFF,      8215000,  USB, FILT2, DATA_OFF,      8215000, LSB, BW2_8, 2800,  PAN_ADAPT,1, AGC_SLOW,OFF,OFF,OFF,OFF,ANT1, 0,  ATTN_OFF,  0,   50,  PREAMP_OFF,  5,  OFF,  NONE,    NONE,     0,  2,   -10,  0x00FF,   0,  180,  255}
 };
 
+// Transverter LO chain, one row per bandmem[] row.  Ignored on bands with no xvtr_IF.
+// lo_base 0 takes the LO from the band edges, fill it in with lo_mult when the LO is a multiplied source.
+// Measure the LO and enter the error in ppb to pull the dial in.  1 ppb at 122GHz is 122Hz.
+struct Xvtr_LO xvtr_lo[BANDS] = {
+    //  lo_base  mult  err_ppb  inject        rx_ofs tx_ofs
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 160M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 80M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 60M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 40M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 30M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 20M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 17M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 15M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 12M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 10M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 6M
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 144
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 222
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 432
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 903
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 1296
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 2400
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 3400
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 5760
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 10G
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 24G
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 47G
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 76G
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0},   // 122G
+    {0,         1,      0,  LO_LOW_SIDE,    0,    0}   // PAN
+};
+
+// Radio settings per transverter band, one row per bandmem[] row.  Starts empty, filled from the radio on band exit.
+struct Radio_Profile radio_profile[BANDS];
+
 // Shared button placement for both RA8875 800x480 and RA8876 1024x600 displays
 #ifdef USE_RA8875   // These rows differ between display sizes. 
     // Button Position variables for easy bulk size, place and move.
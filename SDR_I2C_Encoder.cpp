@@ -810,4 +810,27 @@ COLD void blink_I2C_ENC6_RGB(void)
 	DPRINTLN(F("Blink I2C_ENC6 RGB"));
     I2C_ENC6.writeFadeRGB(3); //Fade enabled with 3ms step
 }
-#endif
\ No newline at end of file
+#endif
+
+// Set every I2C encoder RGB LED to one color without blocking.  Used for alerts such as the TX timeout.
+void set_I2C_Encoders_RGB(uint32_t rgb)
+{
+	#ifdef I2C_ENC1_ADDR
+		I2C_ENC1.writeRGBCode(rgb);
+	#endif
+	#ifdef I2C_ENC2_ADDR
+		I2C_ENC2.writeRGBCode(rgb);
+	#endif
+	#ifdef I2C_ENC3_ADDR
+		I2C_ENC3.writeRGBCode(rgb);
+	#endif
+	#ifdef I2C_ENC4_ADDR
+		I2C_ENC4.writeRGBCode(rgb);
+	#endif
+	#ifdef I2C_ENC5_ADDR
+		I2C_ENC5.writeRGBCode(rgb);
+	#endif
+	#ifdef I2C_ENC6_ADDR
+		I2C_ENC6.writeRGBCode(rgb);
+	#endif
+}
@@ -32,6 +32,7 @@ void blink_I2C_ENC5_RGB(void);
 void blink_I2C_ENC6_RGB(void);
 #endif
 void set_I2CEncoders(void);
+void set_I2C_Encoders_RGB(uint32_t rgb);    // all I2C encoder LEDs to one color, non-blocking
 
 // These are generic callback functions - meaning when a hardware event occurs these functions are 
 // called with the info associated with that encoder.  We can assing each encoder to things like AF and RF gain.
@@ -14,6 +14,8 @@ extern struct   Spectrum_Parms      Sp_Parms_Def[];
 extern struct   Band_Memory         bandmem[];
 extern struct   User_Settings       user_settings[];
 extern struct   Modes_List          modeList[] ;
+extern struct   Xvtr_LO             xvtr_lo[];
+extern struct   Radio_Profile       radio_profile[];
 extern uint8_t  user_Profile;
 
 // *******************************   SD Card  ************************************************************
@@ -41,8 +43,39 @@ SdVolume volume;
 SdFile root;
 File SDR_sd_file;
 void printDirectory(File dir, int numTabs);
-// make a string for assembling the data to log:
-String dataString = "";
+
+// radiocfg.db starts with this header.  The record sizes catch a struct that grew or shrank, bump DB_VERSION when
+// a field changes meaning without changing size.  Files with no header or a different one are not loaded.
+#define DB_MAGIC    0x42444352      // "RCDB"
+#define DB_VERSION  1
+
+struct DB_Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t user_size;         // sizeof each record, in the order they follow the header
+    uint16_t band_size;
+    uint16_t mode_size;
+    uint16_t xvtr_lo_size;
+    uint16_t profile_size;
+    uint8_t  users;             // record counts
+    uint8_t  bands;
+    uint8_t  modes;
+};
+
+static void db_header(struct DB_Header *h)
+{
+    memset(h, 0, sizeof(*h));
+    h->magic        = DB_MAGIC;
+    h->version      = DB_VERSION;
+    h->user_size    = sizeof(user_settings[0]);
+    h->band_size    = sizeof(bandmem[0]);
+    h->mode_size    = sizeof(modeList[0]);
+    h->xvtr_lo_size = sizeof(xvtr_lo[0]);
+    h->profile_size = sizeof(radio_profile[0]);
+    h->users        = USER_SETTINGS_NUM;
+    h->bands        = BANDS;
+    h->modes        = MODES_NUM;
+}
 //
 // *******************************   SD Card  ************************************************************
 
@@ -200,7 +233,12 @@ void write_db_tables(void)
         // Write our data file here
         Serial.println("Copy Database Records from memory to SD Card file radiocfg.db");
         
-        // Start with User Profiles 
+        // Layout header first
+        struct DB_Header hdr;
+        db_header(&hdr);
+        SDR_sd_file.write((const uint8_t *) &hdr, sizeof(hdr));
+
+        // Then User Profiles 
         for (int i = 0; i < USER_SETTINGS_NUM; i++)
         {
             byte dataS[sizeof(user_settings[0])];
@@ -219,13 +257,29 @@ void write_db_tables(void)
         }
 
         // Filter setting per mode on a current band         
-        for (int i = 0; i < BANDS; i++)
+        for (int i = 0; i < MODES_NUM; i++)
         {
             byte dataS[sizeof(modeList[0])];
             memmove(dataS, &modeList[i], sizeof(modeList[i]));
             SDR_sd_file.write(dataS, sizeof(dataS));
         }
 
+        // Transverter LO chain per band
+        for (int i = 0; i < BANDS; i++)
+        {
+            byte dataS[sizeof(xvtr_lo[0])];
+            memmove(dataS, &xvtr_lo[i], sizeof(xvtr_lo[i]));
+            SDR_sd_file.write(dataS, sizeof(dataS));
+        }
+
+        // Transverter band radio profiles
+        for (int i = 0; i < BANDS; i++)
+        {
+            byte dataS[sizeof(radio_profile[0])];
+            memmove(dataS, &radio_profile[i], sizeof(radio_profile[i]));
+            SDR_sd_file.write(dataS, sizeof(dataS));
+        }
+
         // writes for later
             //SDR_sd_file.read(dataS, sizeof(dataS));  //read it back
             //memmove(&user_settings[0], dataS, sizeof(user_settings[i]));
@@ -253,6 +307,21 @@ void read_db_tables(void)
     // if the file is available, read it:
     if (SDR_sd_file) {
         // Read our data file here
+        struct DB_Header hdr, want;
+        uint32_t db_size;
+
+        // Check the layout first.  On any mismatch keep the compiled defaults, the next save rewrites the file.
+        db_header(&want);
+        db_size = sizeof(want) + USER_SETTINGS_NUM * sizeof(user_settings[0])
+                + MODES_NUM * sizeof(modeList[0]) + BANDS * (sizeof(bandmem[0]) + sizeof(xvtr_lo[0]) + sizeof(radio_profile[0]));
+        if (SDR_sd_file.size() != db_size || SDR_sd_file.read((uint8_t *) &hdr, sizeof(hdr)) != sizeof(hdr)
+            || memcmp(&hdr, &want, sizeof(hdr)) != 0)
+        {
+            Serial.println("radiocfg.db is from a different build or is damaged, using compiled defaults");
+            SDR_sd_file.close();
+            return;
+        }
+
         Serial.println("Copy Database Records from SD Card file radiocfg.db to memory");
         // Start with User Profiles 
         for (int i = 0; i < USER_SETTINGS_NUM; i++)
@@ -270,14 +339,30 @@ void read_db_tables(void)
             memmove(&bandmem[i], dataS, sizeof(bandmem[i]));
         }
         
-                // Filter setting per mode on a current band         
-        for (int i = 0; i < BANDS; i++)
+        // Filter setting per mode on a current band         
+        for (int i = 0; i < MODES_NUM; i++)
         {
             byte dataS[sizeof(modeList[0])];
             SDR_sd_file.read(dataS, sizeof(dataS));
             memmove(&modeList[i], dataS, sizeof(modeList[i]));
         }
 
+        // Transverter LO chain per band
+        for (int i = 0; i < BANDS; i++)
+        {
+            byte dataS[sizeof(xvtr_lo[0])];
+            SDR_sd_file.read(dataS, sizeof(dataS));
+            memmove(&xvtr_lo[i], dataS, sizeof(xvtr_lo[i]));
+        }
+
+        // Transverter band radio profiles
+        for (int i = 0; i < BANDS; i++)
+        {
+            byte dataS[sizeof(radio_profile[0])];
+            SDR_sd_file.read(dataS, sizeof(dataS));
+            memmove(&radio_profile[i], dataS, sizeof(radio_profile[i]));
+        }
+
 
         //Serial.println("\nClose File");
         SDR_sd_file.close();
@@ -26,8 +26,9 @@ extern 			int16_t 		barGraph;  // used for remote meter in Panadapter mode
 float Peak_avg(float val);  // calculate average raw smeter readings
 
 ////////////////////////// this is the S meter code/////totall uncalibrated use at your own risk
-COLD float Peak(void)
+PLACE(Peak) float Peak(void)
 {
+   PROF(Peak);
    float s_sample = 0;  // Raw signal strength (max per 1ms)
    float uv, dbuv, s;// microvolts, db-microvolts, s-units
    char string[80];   // print format stuff
@@ -95,8 +96,9 @@ COLD float Peak(void)
 }
 
 // Use the S-meter results to build an average
-HOT float Peak_avg(float val) 
+PLACE(Peak_avg) float Peak_avg(float val) 
 {
+  	PROF(Peak_avg);
   	static int16_t idx = 0;
 	static float sum = 0;
 	static float Readings[WINDOW_SIZE] = {};
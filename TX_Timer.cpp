@@ -0,0 +1,232 @@
+//
+//  TX_Timer.cpp
+//
+//  TX timeout timer and stuck PTT protection.
+//  TX state arrives from the radio over CI-V (as a Radio_State listener), from the PTT_INPUT pin and from the
+//  XMIT button, each through TX_Timer_Update().  A lost RX frame from the radio is covered by polling the radio
+//  TX state every TX_TIMER_POLL_MS.  No poll goes out with NO_SEND 1, during detection or hydration, or while the
+//  link is lost.  The PTT_INPUT pin is still watched then.
+//  TX_TIMER_WARN_S before the band limit the XMIT label changes and the encoder LEDs flash red.
+//  At the limit the radio is sent TX off, PTT_OUT1 goes to RX and the band decode PTT outputs are released.
+//  Any TX seen during the lockout is unkeyed again right away.  Pressing XMIT clears the lockout.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Controls.h"
+#include "Display.h"
+#include "Hydrate.h"
+#include "Band_Table.h"
+#include "Radio_State.h"
+#include "TX_Timer.h"
+#include "Interlock.h"
+#include "Event_Log.h"
+#include "Radio_Model.h"
+#include "Link.h"
+#ifdef I2C_ENCODERS
+    #include "SDR_I2C_Encoder.h"
+#endif
+#include "No_Heap.h"
+
+extern CIV civ;
+extern struct cmdList cmd_List[];
+extern struct Band_Memory bandmem[];
+extern struct Label labels[];
+extern uint8_t curr_band;
+extern uint8_t Check_radio(void);
+
+static uint8_t  tx_sources      = 0;        // TX_Source bits currently keyed
+static uint8_t  tx_stage        = TX_TIMER_IDLE;
+static uint32_t tx_start        = 0;        // millis() when the first source keyed
+static uint32_t tx_flash        = 0;        // millis() of the last LED toggle
+static bool     tx_led_on       = false;
+static uint32_t tx_poll         = 0;        // millis() of the last TX state request
+static bool     tx_poll_waiting = false;
+static uint8_t  ptt_in_last     = 0;
+
+// XMIT label text and encoder LEDs follow the stage
+static void TX_Timer_Alert(uint8_t stage)
+{
+    switch (stage)
+    {
+        case TX_TIMER_WARN:     strcpy(labels[XMIT_LBL].label, "TOT");  break;
+        case TX_TIMER_LOCKOUT:  strcpy(labels[XMIT_LBL].label, "LOCK"); break;
+        default:                strcpy(labels[XMIT_LBL].label, Interlock_Latched() ? "FLT" : Link_Lost() ? "LINK" : "XMIT"); break;
+    }
+    displayXMIT();
+
+    if (stage < TX_TIMER_WARN && tx_led_on)
+    {
+        tx_led_on = false;
+        #ifdef I2C_ENCODERS
+            set_I2C_Encoders_RGB(0x000000);
+        #endif
+    }
+}
+
+// Force RX on every output we control
+void TX_Timer_Unkey(void)
+{
+    uint8_t data_str[2] = {1, 0x00};    // TX off
+
+    civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_TX].cmdData), data_str, CIV_wFast);
+    PTT_Output(curr_band, 0);
+    Xmit(0);    // PTT_OUT1 and DTR
+}
+
+void TX_Timer_Update(uint8_t tx, uint8_t source)
+{
+    uint8_t was = tx_sources;
+
+    if (source >= TX_SOURCES)
+        return;
+
+    if (tx)
+        tx_sources |= (1 << source);
+    else
+        tx_sources &= ~(1 << source);
+
+    if (tx_stage == TX_TIMER_LOCKOUT)
+    {
+        if (tx)
+        {
+            DPRINTF("TX_Timer_Update: TX during lockout, unkeying.  Source "); DPRINTLN(source);
+            TX_Timer_Unkey();
+        }
+        return;
+    }
+
+    if (!was && tx_sources)
+    {
+        tx_start = millis();
+        tx_stage = TX_TIMER_RUN;
+        PTT_Output(curr_band, 1);
+        DPRINTF("TX_Timer_Update: TX start.  Source "); DPRINT(source); DPRINTF("  Limit "); DPRINT(bandmem[curr_band].tx_limit); DPRINTLNF("s");
+    }
+    else if (was && !tx_sources)
+    {
+        if (tx_stage == TX_TIMER_WARN)
+            TX_Timer_Alert(TX_TIMER_IDLE);
+        tx_stage = TX_TIMER_IDLE;
+        PTT_Output(curr_band, 0);
+        DPRINTF("TX_Timer_Update: TX end after "); DPRINT(millis() - tx_start); DPRINTLNF("ms");
+    }
+}
+
+// Ask the radio for its TX state.  Same send-then-listen pattern as Hydrate_Service(), never blocks.
+static void TX_Timer_Poll(uint32_t now)
+{
+    // hydration owns the bus and the replies until it is done, and there is no one to ask while the link is down
+    if (NO_SEND || Hydrate_Busy() || Radio_Model_Busy() || Link_Lost())
+    {
+        tx_poll_waiting = false;
+        return;
+    }
+
+    if (!tx_poll_waiting)
+    {
+        if ((now - tx_poll) < TX_TIMER_POLL_MS)
+            return;
+        civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[CIV_C_TX].cmdData), CIV_D_NIX, CIV_wFast);
+        tx_poll = now;
+        tx_poll_waiting = true;
+        return;
+    }
+
+    Check_radio();  // the reply reaches TX_Timer_Radio() through the radio state model
+    if ((now - tx_poll) >= HYDRATE_REPLY_MS)
+        tx_poll_waiting = false;
+}
+
+PLACE(TX_Timer_Service) void TX_Timer_Service(void)
+{
+    PROF(TX_Timer_Service);
+    uint32_t now = millis();
+    uint32_t limit_ms;
+    uint32_t elapsed;
+    uint8_t  ptt;
+
+    if (PTT_INPUT != GPIO_PIN_NOT_USED)
+    {
+        ptt = (digitalRead(PTT_INPUT) == LOW);  // LOW = TX
+        if (ptt != ptt_in_last)
+        {
+            ptt_in_last = ptt;
+            TX_Timer_Update(ptt, TX_SRC_PTT_IN);
+        }
+    }
+
+    TX_Timer_Poll(now);
+
+    if (tx_stage == TX_TIMER_RUN || tx_stage == TX_TIMER_WARN)
+    {
+        limit_ms = bandmem[curr_band].tx_limit * 1000UL;
+        elapsed  = now - tx_start;
+        if (limit_ms && elapsed >= limit_ms)
+        {
+            DPRINTF("TX_Timer_Service: TX limit reached on "); DPRINT(bandmem[curr_band].band_name); DPRINTLNF(", forcing RX and locking out TX");
+            tx_stage = TX_TIMER_LOCKOUT;
+            TX_Timer_Unkey();
+            Event_Log_Record(EVT_TX_TIMEOUT, curr_band, bandmem[curr_band].tx_limit);
+            TX_Timer_Alert(TX_TIMER_LOCKOUT);
+        }
+        else if (limit_ms && tx_stage == TX_TIMER_RUN && elapsed + TX_TIMER_WARN_S * 1000UL >= limit_ms)
+        {
+            DPRINTF("TX_Timer_Service: TX limit in "); DPRINT((limit_ms - elapsed) / 1000); DPRINTLNF("s");
+            tx_stage = TX_TIMER_WARN;
+            TX_Timer_Alert(TX_TIMER_WARN);
+        }
+    }
+
+    if (tx_stage >= TX_TIMER_WARN && (now - tx_flash) >= TX_TIMER_FLASH_MS)
+    {
+        tx_flash  = now;
+        tx_led_on = !tx_led_on;
+        #ifdef I2C_ENCODERS
+            set_I2C_Encoders_RGB(tx_led_on ? 0xFF0000 : 0x000000);
+        #endif
+    }
+}
+
+// Radio_State listener for RS_TX
+static void TX_Timer_Radio(uint8_t field, int64_t value)
+{
+    if (field == RS_TX)
+        TX_Timer_Update(value ? 1 : 0, TX_SRC_CIV);
+}
+
+COLD void TX_Timer_Init(void)
+{
+    RS_Subscribe(RS_MASK(RS_TX), TX_Timer_Radio);
+}
+
+// A PTT_INPUT still held at this point must release and key again before it counts, a stuck line stays ignored.
+// If the radio itself still reports TX it is timed again from now.
+void TX_Timer_Ack(void)
+{
+    if (tx_stage != TX_TIMER_LOCKOUT)
+        return;
+    tx_sources = 0;
+    tx_stage   = TX_TIMER_IDLE;
+    TX_Timer_Alert(TX_TIMER_IDLE);
+    DPRINTLNF("TX_Timer_Ack: TX lockout cleared");
+    if (RS_Get(RS_TX))
+        TX_Timer_Update(1, TX_SRC_CIV);
+}
+
+bool TX_Timer_Locked(void)
+{
+    return tx_stage == TX_TIMER_LOCKOUT;
+}
+
+uint8_t TX_Timer_Stage(void)
+{
+    return tx_stage;
+}
+
+// Some source is keyed and the outputs follow it.  In lockout they are already forced to RX.
+bool TX_Timer_Keyed(void)
+{
+    return tx_sources != 0 && tx_stage != TX_TIMER_LOCKOUT;
+}
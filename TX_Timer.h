@@ -0,0 +1,35 @@
+#ifndef _TX_TIMER_H_
+#define _TX_TIMER_H_
+//
+//  TX_Timer.h
+//
+//  TX timeout timer and stuck PTT protection.  Limits continuous TX to bandmem[curr_band].tx_limit seconds.
+//  Warns on screen and on the encoder LEDs first, then forces RX and locks out TX until the operator presses XMIT.
+//
+#include <Arduino.h>
+
+// Where a TX state change came from.  Each source keys and unkeys independently, the timer runs while any is keyed.
+enum TX_Source {
+    TX_SRC_CIV,             // radio TX state over CI-V.  Includes TX keyed by a CAT program through the passthrough
+    TX_SRC_PTT_IN,          // PTT_INPUT pin
+    TX_SRC_LOCAL,           // XMIT button
+    TX_SOURCES
+};
+
+enum TX_Stage {
+    TX_TIMER_IDLE,          // RX
+    TX_TIMER_RUN,           // keyed, timing
+    TX_TIMER_WARN,          // keyed, within TX_TIMER_WARN_S of the limit
+    TX_TIMER_LOCKOUT        // forced to RX, waiting for the operator
+};
+
+void TX_Timer_Init(void);                           // subscribe to the radio TX state
+void TX_Timer_Update(uint8_t tx, uint8_t source);   // report a TX (1) or RX (0) state seen from source
+void TX_Timer_Service(void);                        // call every loop pass.  Reads PTT_INPUT, polls the radio, runs the timer
+void TX_Timer_Ack(void);                            // operator acknowledged the timeout, allow TX again
+void TX_Timer_Unkey(void);                          // force RX on the radio, PTT_OUT1 and the band decode PTT outputs
+bool TX_Timer_Locked(void);
+bool TX_Timer_Keyed(void);                          // any source keyed and not locked out
+uint8_t TX_Timer_Stage(void);
+
+#endif // _TX_TIMER_H_
@@ -10,6 +10,7 @@
 #include "CIV-USB-Band-Decoder.h"
 #include "RadioConfig.h"
 #include "Tuner.h"
+#include "Xvtr.h"
 
 extern uint8_t curr_band;   // global tracks our current band setting.
 extern uint64_t VFOA;  // 0 value should never be used more than 1st boot before EEPROM since init should read last used from table.
@@ -33,8 +34,9 @@ static const uint64_t bottomFreq = 1000000; // sets the receiver lower frequency
 //
 //-------------------------- selectFrequency --------------------------------------
 //
-COLD void selectFrequency(int64_t newFreq)  // 0 = no change unless an offset is required for mode
+PLACE(selectFrequency) void selectFrequency(int64_t newFreq)  // 0 = no change unless an offset is required for mode
 {
+    PROF(selectFrequency);
     uint16_t fstep = tstep[bandmem[curr_band].tune_step].step;
   	uint64_t Freq;
 
@@ -70,9 +72,9 @@ COLD void selectFrequency(int64_t newFreq)  // 0 = no change unless an offset is
 		
 		//Now have the correct Freq for VFO A or B when using xit or rit.  Account for Xvtr LO
 		if (user_settings[user_Profile].xmit)
-			Freq += xit_offset - xvtr_offset;  // Add in any XIT offset.  If Xvtr band then remove the LO offset 
+			Freq = Xvtr_RF_to_IF(curr_band, Freq + xit_offset, true);   // Add in any XIT offset.  If Xvtr band then convert to the IF
 		else
-			Freq += rit_offset - xvtr_offset;  // Add in any RIT offset.  If Xvtr band then remove the LO offset 
+			Freq = Xvtr_RF_to_IF(curr_band, Freq + rit_offset, false);  // Add in any RIT offset.  If Xvtr band then convert to the IF
 
 		Freq += Fc;
 		
@@ -5,6 +5,7 @@
 #include "CIV-USB-Band-Decoder.h"
 #include "RadioConfig.h"
 #include "UserInput.h"
+#include "Event_Log.h"
 
 #define BUTTON_TOUCH    8  // distance in pixels that defines a button vs a gesture. A drag and gesture will be > this value.
 //#define MAXTOUCHLIMIT    2  //1...5
@@ -103,8 +104,9 @@ COLD uint8_t get_Touches()
 //      Input:  None.  Assumes the FT5206 touch controller was started in setup()
 //     Output:  Calls Button_Handler() or Gesture_Handler()  
 // 
-COLD void Touch( void)
+PLACE(Touch) void Touch( void)
 {
+    PROF(Touch);
     static uint8_t current_touches = 0;
     static uint8_t previous_touch = 0;
     static uint8_t holdtime = 0;
@@ -440,8 +442,9 @@ void zero_coordinates(void)
 *   So we will track the touch point time and coordinates and figure it out on our own.
 *
 */
-COLD uint8_t Gesture_Handler(uint8_t _gesture, uint8_t _dragEvent, uint8_t _holdtime)
+PLACE(Gesture_Handler) uint8_t Gesture_Handler(uint8_t _gesture, uint8_t _dragEvent, uint8_t _holdtime)
 {
+    PROF(Gesture_Handler);
     if (popup) return 0;  // Ignore gestures when a selection window is active.
 
     // Get our various coordinates
@@ -674,8 +677,9 @@ COLD uint8_t Gesture_Handler(uint8_t _gesture, uint8_t _dragEvent, uint8_t _hold
 //      7.  A multi-function knob or panel switch or remote command may call a control function and no touch involved.
 //      The control and display functions must proceed.
 //  
-COLD void Button_Handler(int16_t x, uint16_t y, uint8_t _holdtime)
+PLACE(Button_Handler) void Button_Handler(int16_t x, uint16_t y, uint8_t _holdtime)
 {
+    PROF(Button_Handler);
     //DPRINT(F("Button:"));DPRINT(x);DPRINT(" ");DPRINTLN(y);
 
     struct Standard_Button *ptr = std_btn; // pointer to standard button layout table
@@ -703,6 +707,7 @@ COLD void Button_Handler(int16_t x, uint16_t y, uint8_t _holdtime)
                     case RIT_BTN:       setRIT(3);      break;
                     case XIT_BTN:       setXIT(3);      break;
                     case XMIT_BTN:      Xmit(2);        break;   // Long press to help avoid accidental transmit
+                    case MENU_BTN:      Event_Log_Show(); break; // recent band, PTT and fault events
                     //case AFGAIN_BTN:    setAFgain(1);   break;
                     case RFGAIN_BTN:    setRFgain(3);   break;  // 
                     default:DPRINT(F("Found a LONG PRESS button with SHOW ON but has no function to call.  Index = "));
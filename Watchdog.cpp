@@ -0,0 +1,150 @@
+//
+//  Watchdog.cpp
+//
+//  Uses WDOG1 through the Watchdog_t4 library.  The library callback runs WATCHDOG_TRIGGER_S ahead of the
+//  hardware reset, that is where the outputs are made safe and the cause is recorded.
+//  The record lives in DMAMEM (RAM2) which the startup code does not clear, a magic number marks it valid.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Band_Table.h"
+#include "Watchdog.h"
+#include "Event_Log.h"
+
+#if defined(USE_WATCHDOG) && !__has_include("Watchdog_t4.h")
+    #warning "USE_WATCHDOG needs the Watchdog_t4 library, building without the hardware watchdog"
+    #undef USE_WATCHDOG
+#endif
+
+#ifdef USE_WATCHDOG
+    #include "Watchdog_t4.h"
+    static WDT_T4<WDT1> wdt;
+#endif
+
+#define WD_RECORD_MAGIC     0x57444F47      // "WDOG"
+
+struct Watchdog_Record {
+    uint32_t magic;
+    uint32_t resets;        // watchdog resets since power up
+    uint32_t uptime_ms;     // millis() when the fault fired
+    uint8_t  missing;       // stages that had not checked in
+};
+
+DMAMEM static struct Watchdog_Record wd_record;     // not cleared on reset
+
+static volatile uint8_t wd_checkins = 0;            // stages seen this pass
+static uint8_t wd_stalled = 0;                      // stages held off by Watchdog_Inject_Stall()
+
+// Drives the pins directly.  No debug prints, this can run in the watchdog interrupt.
+void Watchdog_Safe_State(void)
+{
+    if (PTT_OUT1 != GPIO_PIN_NOT_USED)
+        digitalWrite(PTT_OUT1, HIGH);   // HIGH = RX
+
+    for (uint8_t i = 0; i < BAND_DECODE_BITS; i++)
+    {
+        if (band_decode_ptt_pins[i] != GPIO_PIN_NOT_USED)
+            digitalWrite(band_decode_ptt_pins[i], LOW);
+        if (band_decode_pins[i] != GPIO_PIN_NOT_USED)
+            digitalWrite(band_decode_pins[i], (WATCHDOG_SAFE_DECODE >> i) & 1);
+    }
+}
+
+#ifdef USE_WATCHDOG
+// Watchdog interrupt.  The loop has been stuck for WATCHDOG_TIMEOUT_S - WATCHDOG_TRIGGER_S seconds.
+static void Watchdog_Fault(void)
+{
+    Watchdog_Safe_State();
+
+    if (wd_record.magic != WD_RECORD_MAGIC)
+    {
+        wd_record.magic  = WD_RECORD_MAGIC;
+        wd_record.resets = 0;
+    }
+    wd_record.resets++;
+    wd_record.uptime_ms = millis();
+    wd_record.missing   = WD_STAGE_ALL & ~wd_checkins;
+    arm_dcache_flush(&wd_record, sizeof(wd_record));    // RAM2 is cached, push it out before the reset
+    Event_Log_Record(EVT_WATCHDOG, wd_record.missing, 0);
+}
+#endif
+
+COLD void Watchdog_Init(void)
+{
+    wd_checkins = 0;
+    #ifdef USE_WATCHDOG
+        WDT_timings_t config;
+        config.trigger  = WATCHDOG_TRIGGER_S;
+        config.timeout  = WATCHDOG_TIMEOUT_S;
+        config.callback = Watchdog_Fault;
+        wdt.begin(config);
+        DPRINTF("Watchdog_Init: Timeout "); DPRINT(WATCHDOG_TIMEOUT_S); DPRINTF("s  Safe state at "); DPRINT(WATCHDOG_TIMEOUT_S - WATCHDOG_TRIGGER_S); DPRINTLNF("s");
+    #else
+        DPRINTLNF("Watchdog_Init: USE_WATCHDOG not defined, watchdog off");
+    #endif
+}
+
+HOT void Watchdog_Checkin(uint8_t stage)
+{
+    if (stage < WD_STAGES && !(wd_stalled & (1 << stage)))
+        wd_checkins |= (1 << stage);
+}
+
+PLACE(Watchdog_Service) void Watchdog_Service(void)
+{
+    PROF(Watchdog_Service);
+    Watchdog_Checkin(WD_STAGE_LOOP);
+    if (wd_checkins != WD_STAGE_ALL)
+        return;
+    wd_checkins = 0;
+    #ifdef USE_WATCHDOG
+        wdt.feed();
+    #endif
+}
+
+// Run early in setup().  Prints why the last reset happened if it was us.
+COLD void Watchdog_Report(void)
+{
+    if (wd_record.magic != WD_RECORD_MAGIC || wd_record.uptime_ms == 0)
+        return;
+
+    DPRINTF("Watchdog_Report: Reset by watchdog after "); DPRINT(wd_record.uptime_ms); DPRINTF("ms uptime.  Stages missing: ");
+    for (uint8_t i = 0; i < WD_STAGES; i++)
+    {
+        if (wd_record.missing & (1 << i))
+        {
+            DPRINT(Watchdog_Stage_Name(i)); DPRINTF(" ");
+        }
+    }
+    DPRINTF(" Watchdog resets since power up: "); DPRINTLN(wd_record.resets);
+
+    wd_record.missing   = 0;
+    wd_record.uptime_ms = 0;
+    arm_dcache_flush(&wd_record, sizeof(wd_record));
+}
+
+// Stages check in in Watchdog_Stage order, so the first one missing this pass is the one running now
+uint8_t Watchdog_Stage_Now(void)
+{
+    for (uint8_t i = 0; i < WD_STAGES; i++)
+        if (!(wd_checkins & (1 << i)))
+            return i;
+    return WD_STAGE_LOOP;
+}
+
+const char * Watchdog_Stage_Name(uint8_t stage)
+{
+    static const char * const names[WD_STAGES] = {"CAT", "RADIO", "UI", "LOOP"};
+
+    return stage < WD_STAGES ? names[stage] : "?";
+}
+
+// Test hook.  The named stage stops checking in, the safe state should follow within
+// WATCHDOG_TIMEOUT_S - WATCHDOG_TRIGGER_S seconds and a reset at WATCHDOG_TIMEOUT_S.
+COLD void Watchdog_Inject_Stall(uint8_t stage)
+{
+    if (stage < WD_STAGES)
+        wd_stalled |= (1 << stage);
+    DPRINTF("Watchdog_Inject_Stall: Stage "); DPRINTLN(stage);
+}
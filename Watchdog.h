@@ -0,0 +1,32 @@
+#ifndef _WATCHDOG_H_
+#define _WATCHDOG_H_
+//
+//  Watchdog.h
+//
+//  Main loop watchdog.  Each stage of loop() checks in once per pass.  The hardware watchdog is only fed when
+//  every stage has checked in, so a hang anywhere (USB Host read, I2C bus, display) stops the feeding.
+//  Before the reset the PTT outputs are dropped to RX and the band decode outputs go to WATCHDOG_SAFE_DECODE.
+//  The cause is kept in RAM that survives the reset and printed on the next boot.
+//
+#include <Arduino.h>
+
+enum Watchdog_Stage {
+    WD_STAGE_CAT,           // CAT passthrough, USB Host reads
+    WD_STAGE_RADIO,         // radio message handling
+    WD_STAGE_UI,            // touch, encoders, switches
+    WD_STAGE_LOOP,          // end of loop(), covers display and everything else
+    WD_STAGES
+};
+
+#define WD_STAGE_ALL        ((1 << WD_STAGES) - 1)
+
+void Watchdog_Init(void);                           // call at the end of setup()
+void Watchdog_Checkin(uint8_t stage);
+void Watchdog_Service(void);                        // call at the end of each loop() pass
+void Watchdog_Safe_State(void);                     // PTT to RX, band decode to the safe code.  Safe from an ISR.
+void Watchdog_Report(void);                         // print and clear the reset cause saved before the last reset
+uint8_t Watchdog_Stage_Now(void);                   // loop() stage running now.  Safe from a fault handler
+const char * Watchdog_Stage_Name(uint8_t stage);
+void Watchdog_Inject_Stall(uint8_t stage);          // test: stop that stage's check ins to prove the fault path
+
+#endif // _WATCHDOG_H_
@@ -0,0 +1,139 @@
+//
+//  Write_Combine.cpp
+//
+//  A write for a parameter that has not been sent within its spacing goes straight out, so a single knob click is not
+//  delayed.  Inside the spacing it is parked in the parameter's slot and overwritten by anything newer.
+//  The slot keeps the time its oldest unsent value arrived, which gives the knob to radio lag when it finally goes.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Write_Combine.h"
+#include "Radio_Model.h"
+#include "No_Heap.h"
+
+extern CIV civ;
+
+struct WC_Slot {
+    uint8_t     cmd[WC_CMD_MAX];    // cmd[0] = 0 for a free slot
+    uint8_t     data[WC_DATA_MAX];
+    writeMode_t mode;
+    bool        pending;
+    uint16_t    spacing_ms;
+    uint32_t    sent_ms;            // millis() of the last frame for this parameter
+    uint32_t    queued_ms;          // millis() the oldest unsent value arrived
+};
+
+static struct WC_Slot wc_slot[WC_SLOTS];
+static struct WC_Stats wc_stats;
+static uint8_t wc_waiting = 0;      // slots pending, lets WC_Service() return early
+
+static void WC_Send(struct WC_Slot *s, uint32_t now)
+{
+    civ.writeMsg(radio_addr, s->cmd, s->data, s->mode);
+    wc_stats.sent++;
+    if (s->pending)
+    {
+        s->pending = false;
+        wc_waiting--;
+        wc_stats.last_lag_ms = now - s->queued_ms;
+        if (wc_stats.last_lag_ms > wc_stats.max_lag_ms)
+            wc_stats.max_lag_ms = wc_stats.last_lag_ms;
+    }
+    s->sent_ms = now;
+}
+
+// The parameter's slot, else a free one, else the idle one used longest ago
+static struct WC_Slot * WC_Find(const uint8_t *cmd)
+{
+    struct WC_Slot *idle = NULL;
+
+    for (uint8_t i = 0; i < WC_SLOTS; i++)
+    {
+        struct WC_Slot *s = &wc_slot[i];
+
+        if (s->cmd[0] && memcmp(s->cmd, cmd, s->cmd[0] + 1) == 0)
+            return s;
+        if (s->pending)
+            continue;
+        if (!idle || !s->cmd[0] || (idle->cmd[0] && (int32_t) (s->sent_ms - idle->sent_ms) < 0))
+            idle = s;
+    }
+    if (idle)
+    {
+        memcpy(idle->cmd, cmd, cmd[0] + 1);
+        idle->sent_ms = millis() - 0x80000000UL;    // never sent
+    }
+    return idle;
+}
+
+PLACE(WC_Write) void WC_Write(const uint8_t *cmd, const uint8_t *data, uint16_t spacing_ms, writeMode_t mode)
+{
+    PROF(WC_Write);
+    uint32_t now = millis();
+    struct WC_Slot *s;
+
+    wc_stats.writes++;
+    if (cmd[0] >= WC_CMD_MAX || data[0] >= WC_DATA_MAX || (s = WC_Find(cmd)) == NULL)
+    {
+        wc_stats.no_slot++;
+        civ.writeMsg(radio_addr, cmd, data, mode);
+        wc_stats.sent++;
+        return;
+    }
+
+    memcpy(s->data, data, data[0] + 1);
+    s->mode       = mode;
+    s->spacing_ms = spacing_ms;
+    if (s->pending)
+    {
+        wc_stats.combined++;
+        return;
+    }
+    if ((now - s->sent_ms) >= spacing_ms)
+    {
+        WC_Send(s, now);
+        return;
+    }
+    s->pending   = true;
+    s->queued_ms = now;
+    wc_waiting++;
+}
+
+PLACE(WC_Service) void WC_Service(void)
+{
+    PROF(WC_Service);
+    uint32_t now;
+
+    if (!wc_waiting)
+        return;
+    now = millis();
+    for (uint8_t i = 0; i < WC_SLOTS; i++)
+    {
+        if (wc_slot[i].pending && (now - wc_slot[i].sent_ms) >= wc_slot[i].spacing_ms)
+            WC_Send(&wc_slot[i], now);
+    }
+}
+
+const struct WC_Stats * WC_Get_Stats(void)
+{
+    return &wc_stats;
+}
+
+// Same rule as CIV_Stats_Show_Stats(), only when something changed
+COLD void WC_Show_Stats(void)
+{
+    static struct WC_Stats last;
+
+    if (memcmp(&last, &wc_stats, sizeof(wc_stats)) == 0)
+        return;
+    last = wc_stats;
+
+    DPRINTF("Write_Combine: writes="); DPRINT(wc_stats.writes);
+    DPRINTF(" sent="); DPRINT(wc_stats.sent);
+    DPRINTF(" combined="); DPRINT(wc_stats.combined);
+    DPRINTF(" lag_ms="); DPRINT(wc_stats.last_lag_ms);
+    DPRINTF(" max_lag_ms="); DPRINT(wc_stats.max_lag_ms);
+    DPRINTF(" no_slot="); DPRINTLN(wc_stats.no_slot);
+}
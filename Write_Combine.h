@@ -0,0 +1,32 @@
+#ifndef _WRITE_COMBINE_H_
+#define _WRITE_COMBINE_H_
+//
+//  Write_Combine.h
+//
+//  Latest value wins for CI-V setting writes that can come faster than the link carries them, such as the VFO on a
+//  spinning encoder.  Writes are keyed by command and sub command.  A write for a parameter sent less than its spacing
+//  ago waits in a slot, a newer value for it replaces the waiting one, and WC_Service() sends it when the spacing is up.
+//  The last value written is always the one the radio ends up with.
+//
+#include <Arduino.h>
+#include <CIVmaster.h>
+
+#define WC_SLOTS            6       // parameters tracked at once
+#define WC_CMD_MAX          5       // cmdData bytes, length then command and sub commands
+#define WC_DATA_MAX         8       // data bytes, length then up to 7 data bytes
+
+struct WC_Stats {
+    uint32_t writes;        // WC_Write() calls
+    uint32_t sent;          // frames sent to the radio
+    uint32_t combined;      // values replaced before they were sent
+    uint32_t last_lag_ms;   // oldest unsent value to the frame that carried its replacement
+    uint32_t max_lag_ms;
+    uint32_t no_slot;       // every slot busy, sent at once
+};
+
+void WC_Write(const uint8_t *cmd, const uint8_t *data, uint16_t spacing_ms, writeMode_t mode);
+void WC_Service(void);                  // call every loop pass.  Sends waiting values whose spacing is up
+const struct WC_Stats * WC_Get_Stats(void);
+void WC_Show_Stats(void);
+
+#endif // _WRITE_COMBINE_H_
@@ -0,0 +1,172 @@
+//
+//  Xcv_Track.cpp
+//
+//  An idle radio with Transceive on sends nothing, so silence alone cannot tell on from off.  The check read settles
+//  it: the same frequency back means nothing was missed and polling stays off.  A different frequency, while ours was
+//  not still waiting on the radio (RS_SRC_PENDING after SetFreq()), is a missed report.
+//  Reads use the same send-then-listen pattern as Hydrate_Service() and stay off the bus during TX, detection,
+//  hydration and a link loss.  While polling, every XCV_POLL_SLOW_MS one of the reads is the mode instead.
+//  With NO_SEND 1 nothing is read, the reports are still counted and the frequency follows them alone.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Hydrate.h"
+#include "Radio_State.h"
+#include "Radio_Model.h"
+#include "Link.h"
+#include "Xcv_Track.h"
+#include "No_Heap.h"
+
+extern CIV civ;
+extern struct cmdList cmd_List[];
+extern struct User_Settings user_settings[];
+extern uint8_t user_Profile;
+extern uint8_t Check_radio(void);
+
+static struct Xcv_Stats xcv_stats;
+static bool     xcv_polling = false;
+static bool     xcv_dropped = false;
+static bool     xcv_waiting = false;
+static bool     xcv_check   = false;    // the read out is a check in transceive mode
+static uint32_t xcv_sent    = 0;        // millis() of the last read
+static uint32_t xcv_freq_ms = 0;        // millis() of the last frequency frame, reply or report
+static uint32_t xcv_moved   = 0;        // millis() the frequency last changed
+static uint32_t xcv_mode_ms = 0;        // millis() of the last mode read while polling
+
+// An unsolicited frame, Transceive is on in the radio
+static void Xcv_Report(void)
+{
+    xcv_stats.reports++;
+    if (xcv_polling)
+    {
+        xcv_polling = false;
+        xcv_stats.resumes++;
+        DPRINTLNF("Xcv_Track: Transceive reports are back, polling off");
+    }
+}
+
+HOT void Xcv_Freq(uint64_t freq, bool report)
+{
+    uint32_t now = millis();
+    bool changed = (int64_t) freq != RS_Get(RS_FREQ);
+
+    if (xcv_freq_ms)
+    {
+        xcv_stats.last_stale_ms = now - xcv_freq_ms;
+        if (xcv_stats.last_stale_ms > xcv_stats.max_stale_ms)
+            xcv_stats.max_stale_ms = xcv_stats.last_stale_ms;
+    }
+    xcv_freq_ms = now;
+    if (changed)
+        xcv_moved = now;
+
+    if (report)
+    {
+        Xcv_Report();
+        return;
+    }
+    if (xcv_waiting && xcv_check && changed && RS_Source(RS_FREQ) == RS_SRC_RADIO)
+    {
+        xcv_polling = true;
+        xcv_stats.missed++;
+        DPRINTLNF("Xcv_Track: Frequency changed without a transceive report, polling");
+    }
+    xcv_waiting = false;
+}
+
+HOT void Xcv_Mode(bool report)
+{
+    if (report)
+        Xcv_Report();
+    else
+        xcv_waiting = false;
+}
+
+static void Xcv_Read(uint8_t cmd, uint32_t now)
+{
+    civ.writeMsg(radio_addr, reinterpret_cast<const uint8_t*>(&cmd_List[cmd].cmdData), CIV_D_NIX, CIV_wFast);
+    xcv_sent    = now;
+    xcv_waiting = true;
+    xcv_stats.polls++;
+}
+
+PLACE(Xcv_Service) void Xcv_Service(void)
+{
+    PROF(Xcv_Service);
+    uint32_t now = millis();
+    uint32_t interval;
+
+    if (NO_SEND || Link_Lost() || Radio_Model_Busy() || Hydrate_Busy() || user_settings[user_Profile].xmit)
+    {
+        xcv_waiting = false;
+        return;
+    }
+
+    if (xcv_waiting)
+    {
+        Check_radio();  // the reply comes back through Xcv_Freq() or Xcv_Mode()
+        if (xcv_waiting && (now - xcv_sent) >= HYDRATE_REPLY_MS)
+            xcv_waiting = false;
+        return;
+    }
+
+    if (!xcv_polling)
+        interval = XCV_CHECK_MS;
+    else if ((now - xcv_moved) < XCV_MOVING_MS)
+        interval = XCV_POLL_FAST_MS;
+    else
+        interval = XCV_POLL_SLOW_MS;
+    if ((now - xcv_freq_ms) < interval || (now - xcv_sent) < interval)
+        return;
+
+    xcv_check = !xcv_polling;
+    if (xcv_polling && (now - xcv_mode_ms) >= XCV_POLL_SLOW_MS)
+    {
+        xcv_mode_ms = now;
+        Xcv_Read(Radio_Model_Has(RM_CMD_F26) ? CIV_C_F26A : CIV_C_MOD_READ, now);
+    }
+    else
+        Xcv_Read(CIV_C_F_READ, now);
+}
+
+bool Xcv_Polling(void)
+{
+    return xcv_polling;
+}
+
+// Test hook.  check_CIV() throws away the unsolicited reports while on, replies to reads still get through.
+COLD void Xcv_Drop(bool on)
+{
+    xcv_dropped = on;
+    DPRINTLN(on ? "Xcv_Drop: Ignoring transceive reports" : "Xcv_Drop: Taking transceive reports again");
+}
+
+bool Xcv_Dropped(void)
+{
+    return xcv_dropped;
+}
+
+const struct Xcv_Stats * Xcv_Get_Stats(void)
+{
+    return &xcv_stats;
+}
+
+// Same rule as CIV_Stats_Show_Stats(), only when the tracking changed hands
+COLD void Xcv_Show_Stats(void)
+{
+    static uint32_t last_missed = 0, last_resumes = 0;
+
+    if (xcv_stats.missed == last_missed && xcv_stats.resumes == last_resumes)
+        return;
+    last_missed  = xcv_stats.missed;
+    last_resumes = xcv_stats.resumes;
+
+    DPRINTF("Xcv: reports="); DPRINT(xcv_stats.reports);
+    DPRINTF(" polls="); DPRINT(xcv_stats.polls);
+    DPRINTF(" missed="); DPRINT(xcv_stats.missed);
+    DPRINTF(" resumes="); DPRINT(xcv_stats.resumes);
+    DPRINTF(" stale_ms="); DPRINT(xcv_stats.last_stale_ms);
+    DPRINTF(" max_stale_ms="); DPRINTLN(xcv_stats.max_stale_ms);
+}
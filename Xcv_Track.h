@@ -0,0 +1,31 @@
+#ifndef _XCV_TRACK_H_
+#define _XCV_TRACK_H_
+//
+//  Xcv_Track.h
+//
+//  Frequency tracking when the radio's CI-V Transceive setting is off.  Unsolicited frequency and mode reports keep
+//  polling at zero.  Without them the frequency is read every XCV_CHECK_MS, and a reading that differs from the last
+//  known frequency means a change went unreported: polling takes over, XCV_POLL_FAST_MS while the VFO is moving and
+//  XCV_POLL_SLOW_MS when idle, until the next unsolicited report.
+//
+#include <Arduino.h>
+
+struct Xcv_Stats {
+    uint32_t reports;           // unsolicited frequency and mode frames
+    uint32_t polls;             // frequency and mode reads sent, checks included
+    uint32_t missed;            // check reads that found a change transceive did not report
+    uint32_t resumes;           // polling handed back to transceive
+    uint32_t last_stale_ms;     // time between the last two frequency frames from the radio
+    uint32_t max_stale_ms;
+};
+
+void Xcv_Service(void);                         // call every loop pass.  Check and poll reads, never blocks
+void Xcv_Freq(uint64_t freq, bool report);      // check_CIV() on every frequency frame, before RS_Radio().  report = unsolicited
+void Xcv_Mode(bool report);                     // check_CIV() on every mode frame
+bool Xcv_Polling(void);
+void Xcv_Drop(bool on);                         // test: ignore unsolicited reports, as if Transceive were off in the radio
+bool Xcv_Dropped(void);
+const struct Xcv_Stats * Xcv_Get_Stats(void);
+void Xcv_Show_Stats(void);
+
+#endif // _XCV_TRACK_H_
@@ -0,0 +1,162 @@
+//
+//  Xvtr.cpp
+//
+//  Transverter frequency translation engine.
+//  The LO is modeled as a base oscillator times a multiplier, corrected by a measured error in ppb.
+//  The corrected LO is computed in milliHz and rounded once to whole Hz, then all RF <-> IF math is plain
+//  integer add/subtract so converting one way and back always returns the starting frequency.
+//
+//  Low side LO:   RF = IF + LO
+//  High side LO:  RF = LO - IF, the radio tunes backwards and USB/LSB, CW/CW-R, RTTY/RTTY-R swap.
+//
+//  rx_offset and tx_offset are applied on the radio side to correct a dial error in the IF radio.
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "Xvtr.h"
+
+extern struct Band_Memory bandmem[];
+extern struct Xvtr_LO xvtr_lo[];
+
+bool Xvtr_Active(uint8_t band)
+{
+    return (band < BANDS && bandmem[band].xvtr_IF && bandmem[band].xvtr_IF < BANDS);
+}
+
+// LO in Hz before error correction
+static int64_t Xvtr_LO_Nominal(uint8_t band)
+{
+    struct Xvtr_LO *lo = &xvtr_lo[band];
+    uint8_t if_band = bandmem[band].xvtr_IF;
+
+    if (lo->lo_base)
+        return (int64_t) lo->lo_base * (lo->lo_mult ? lo->lo_mult : 1);
+
+    // No base LO entered so line the band edges up.  High side: the bottom of the RF band is the top of the IF band.
+    if (lo->lo_inject == LO_HIGH_SIDE)
+        return (int64_t) bandmem[band].edge_lower + (int64_t) bandmem[if_band].edge_upper;
+    return (int64_t) bandmem[band].edge_lower - (int64_t) bandmem[if_band].edge_lower;
+}
+
+int64_t Xvtr_LO_mHz(uint8_t band)
+{
+    int64_t lo;
+    int32_t ppb;
+
+    if (!Xvtr_Active(band))
+        return 0;
+
+    lo  = Xvtr_LO_Nominal(band);
+    ppb = constrain(xvtr_lo[band].lo_err_ppb, -XVTR_PPB_MAX, XVTR_PPB_MAX);
+    return lo * 1000 + (lo * ppb) / 1000000;   // Hz * ppb / 1e9 = Hz error, * 1000 for mHz
+}
+
+int64_t Xvtr_LO_Hz(uint8_t band)
+{
+    int64_t mhz = Xvtr_LO_mHz(band);
+
+    return (mhz >= 0) ? (mhz + 500) / 1000 : (mhz - 500) / 1000;
+}
+
+PLACE(Xvtr_RF_to_IF) uint64_t Xvtr_RF_to_IF(uint8_t band, uint64_t rf, bool tx)
+{
+    PROF(Xvtr_RF_to_IF);
+    int64_t lo;
+    int64_t f;
+
+    if (!Xvtr_Active(band))
+        return rf;
+
+    lo = Xvtr_LO_Hz(band);
+    if (xvtr_lo[band].lo_inject == LO_HIGH_SIDE)
+        f = lo - (int64_t) rf;
+    else
+        f = (int64_t) rf - lo;
+    f += tx ? xvtr_lo[band].tx_offset : xvtr_lo[band].rx_offset;
+
+    return (f < 0) ? 0 : (uint64_t) f;   // never hand a negative (huge unsigned) frequency to the radio
+}
+
+PLACE(Xvtr_IF_to_RF) uint64_t Xvtr_IF_to_RF(uint8_t band, uint64_t radio_if, bool tx)
+{
+    PROF(Xvtr_IF_to_RF);
+    int64_t lo;
+    int64_t f;
+
+    if (!Xvtr_Active(band))
+        return radio_if;
+
+    lo = Xvtr_LO_Hz(band);
+    f  = (int64_t) radio_if - (tx ? xvtr_lo[band].tx_offset : xvtr_lo[band].rx_offset);
+    if (xvtr_lo[band].lo_inject == LO_HIGH_SIDE)
+        f = lo - f;
+    else
+        f = f + lo;
+
+    return (f < 0) ? 0 : (uint64_t) f;
+}
+
+// mode_num is the radio's CI-V mode byte (modeList[].mode_num)
+uint8_t Xvtr_Radio_Mode(uint8_t band, uint8_t mode_num)
+{
+    if (!Xvtr_Active(band) || xvtr_lo[band].lo_inject != LO_HIGH_SIDE)
+        return mode_num;
+
+    switch (mode_num)
+    {
+        case 0x00: return 0x01;     // LSB  -> USB
+        case 0x01: return 0x00;     // USB  -> LSB
+        case 0x03: return 0x07;     // CW   -> CW-R
+        case 0x07: return 0x03;     // CW-R -> CW
+        case 0x04: return 0x08;     // RTTY -> RTTY-R
+        case 0x08: return 0x04;     // RTTY-R -> RTTY
+        default:   return mode_num;
+    }
+}
+
+// Run once after the band table is loaded.  Converts each transverter band's edges and center to IF and back
+// and reports any that do not come back exactly, plus bands whose RF range runs outside the IF band.
+COLD void Xvtr_Check(void)
+{
+    uint8_t bad = 0;
+
+    for (uint8_t band = 0; band < BANDS; band++)
+    {
+        uint8_t  if_band;
+        uint64_t rf[3];
+        bool     outside = false;
+
+        if (!Xvtr_Active(band))
+            continue;
+
+        if_band = bandmem[band].xvtr_IF;
+        rf[0] = bandmem[band].edge_lower;
+        rf[1] = bandmem[band].edge_lower + (bandmem[band].edge_upper - bandmem[band].edge_lower) / 2;
+        rf[2] = bandmem[band].edge_upper;
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            for (uint8_t tx = 0; tx < 2; tx++)
+            {
+                uint64_t radio_if = Xvtr_RF_to_IF(band, rf[i], tx);
+
+                if (Xvtr_IF_to_RF(band, radio_if, tx) != rf[i])
+                {
+                    DPRINTF("Xvtr_Check: Round trip error Band "); DPRINT(bandmem[band].band_name);
+                    DPRINTF("  RF "); DPRINT(rf[i]); DPRINTF("  IF "); DPRINT(radio_if);
+                    DPRINTF("  LO "); DPRINTLN(Xvtr_LO_Hz(band));
+                    bad++;
+                }
+                if (radio_if < bandmem[if_band].edge_lower || radio_if > bandmem[if_band].edge_upper)
+                    outside = true;
+            }
+        }
+        if (outside)
+        {
+            DPRINTF("Xvtr_Check: Band "); DPRINT(bandmem[band].band_name); DPRINTF(" extends past IF band ");
+            DPRINT(bandmem[if_band].band_name); DPRINTF("  LO "); DPRINTLN(Xvtr_LO_Hz(band));
+        }
+    }
+    DPRINTF("Xvtr_Check: Complete, "); DPRINT(bad); DPRINTLNF(" round trip errors");
+}
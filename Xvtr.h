@@ -0,0 +1,22 @@
+#ifndef _XVTR_H_
+#define _XVTR_H_
+//
+//  Xvtr.h
+//
+//  Transverter frequency translation.  One place converts between the RF dial frequency we show and the
+//  IF frequency the radio is tuned to, for both the tuning path (Tuner.cpp) and the radio report path (Check_radio).
+//  The LO chain for each band is in xvtr_lo[] (SDR_Data.h), same index as bandmem[].
+//
+#include <Arduino.h>
+
+#define XVTR_PPB_MAX        1000000     // clamp on lo_err_ppb, +/-1000ppm keeps the mHz math inside int64 at 122GHz
+
+bool     Xvtr_Active(uint8_t band);                                 // band has an IF band assigned
+int64_t  Xvtr_LO_mHz(uint8_t band);                                 // corrected LO in milliHz, 0 if not a transverter band
+int64_t  Xvtr_LO_Hz(uint8_t band);                                  // corrected LO rounded to the nearest Hz
+uint64_t Xvtr_RF_to_IF(uint8_t band, uint64_t rf, bool tx);         // dial to radio
+uint64_t Xvtr_IF_to_RF(uint8_t band, uint64_t radio_if, bool tx);   // radio to dial
+uint8_t  Xvtr_Radio_Mode(uint8_t band, uint8_t mode_num);           // swap sidebands on high side LO bands.  Works both directions.
+void     Xvtr_Check(void);                                          // boot time round trip check of every band
+
+#endif // _XVTR_H_
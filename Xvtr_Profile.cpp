@@ -0,0 +1,162 @@
+//
+//  Xvtr_Profile.cpp
+//
+//  Save and restore radio settings per transverter band.
+//  changeBands() calls Xvtr_Profile_Exit() before it leaves a band and Xvtr_Profile_Enter() after the new band's
+//  mode is set.  Exit reads every enabled field from the radio, which also tells Enter what the radio holds right
+//  now, so only the fields that differ are written back.  The reads block, so a change between two bands that are
+//  not transverter bands skips them.  Profiles are saved to SD with bandmem[].
+//
+
+#include "CIV-USB-Band-Decoder.h"
+#include "RadioConfig.h"
+#include "CIV.h"
+#include "Xvtr.h"
+#include "Xvtr_Profile.h"
+#include "Radio_Model.h"
+
+extern CIV civ;
+extern struct Band_Memory bandmem[];
+extern struct Radio_Profile radio_profile[];
+
+static_assert(PROF_FIELDS == XVTR_PROF_FIELDS, "Profile_Field and struct Radio_Profile disagree");
+
+struct Profile_Cmd {
+    char    name[10];
+    uint8_t cmd[3];         // same layout as cmd_List[] cmdData, [0] = length
+    uint8_t level;          // 1 = 2 byte BCD level 0-255, 0 = 1 byte switch
+};
+
+// NB and NR on/off are not in cmd_List[]
+static const struct Profile_Cmd prof_cmd[PROF_FIELDS] = {
+    {"RF Power", {2,0x14,0x0A}, 1},
+    {"RF Gain",  {2,0x14,0x02}, 1},
+    {"NB",       {2,0x16,0x22}, 0},
+    {"NB Level", {2,0x14,0x12}, 1},
+    {"NR",       {2,0x16,0x40}, 0},
+    {"NR Level", {2,0x14,0x06}, 1}
+};
+
+static struct Radio_Profile radio_now;  // what the radio held at the last exit read.  Used once by the next Enter.
+
+static bool Xvtr_Profile_Read(uint8_t field, uint16_t *value)
+{
+    CIVresult_t CIVresultL;
+    uint8_t len;
+
+    CIVresultL = civ.writeMsg(radio_addr, prof_cmd[field].cmd, CIV_D_NIX, CIV_wChk);
+    if (CIVresultL.retVal != CIV_OK_DAV)
+        return false;
+    len = CIVresultL.datafield[0];
+    if (len != (prof_cmd[field].level ? 2 : 1) || !CIV_BCD_Valid(&CIVresultL.datafield[1], len))
+        return false;
+    *value = (uint16_t) CIV_BCD_Num_Decode(&CIVresultL.datafield[1], len);
+    return true;
+}
+
+static bool Xvtr_Profile_Write(uint8_t field, uint16_t value)
+{
+    CIVresult_t CIVresultL;
+    uint8_t data_str[3];
+
+    if (prof_cmd[field].level)
+    {
+        data_str[0] = 2;
+        data_str[1] = bcdByteEncode(value / 100);
+        data_str[2] = bcdByteEncode(value % 100);
+    }
+    else
+    {
+        data_str[0] = 1;
+        data_str[1] = value ? 1 : 0;
+    }
+    CIVresultL = civ.writeMsg(radio_addr, prof_cmd[field].cmd, data_str, CIV_wChk);
+    return CIVresultL.retVal == CIV_OK;
+}
+
+COLD void Xvtr_Profile_Exit(uint8_t band, uint8_t next)
+{
+    uint16_t value;
+
+    radio_now.valid = 0;
+    if (NO_SEND || !XVTR_PROFILE_FIELDS || band >= BANDS || next >= BANDS)
+        return;
+    if (!Xvtr_Active(band) && !Xvtr_Active(next))
+        return;     // HF to HF and such, nothing to save and nothing to restore
+
+    for (uint8_t i = 0; i < PROF_FIELDS; i++)
+    {
+        if (!(XVTR_PROFILE_FIELDS & (1 << i)))
+            continue;
+        if (!Xvtr_Profile_Read(i, &value))
+        {
+            DPRINTF("Xvtr_Profile_Exit: no reply for "); DPRINTLN(prof_cmd[i].name);
+            continue;
+        }
+        radio_now.value[i] = value;
+        radio_now.valid   |= (1 << i);
+    }
+
+    if (Xvtr_Active(band))
+    {
+        // Fields the radio did not answer keep their last saved value
+        for (uint8_t i = 0; i < PROF_FIELDS; i++)
+            if (radio_now.valid & (1 << i))
+                radio_profile[band].value[i] = radio_now.value[i];
+        radio_profile[band].valid |= radio_now.valid;
+        DPRINTF("Xvtr_Profile_Exit: saved profile for "); DPRINTLN(bandmem[band].band_name);
+    }
+}
+
+COLD uint8_t Xvtr_Profile_Enter(uint8_t band)
+{
+    struct Radio_Profile *p;
+    uint8_t writes = 0;
+
+    if (NO_SEND || !XVTR_PROFILE_FIELDS || band >= BANDS || !Xvtr_Active(band))
+    {
+        radio_now.valid = 0;
+        return 0;
+    }
+
+    p = &radio_profile[band];
+    for (uint8_t i = 0; i < PROF_FIELDS; i++)
+    {
+        if (!(XVTR_PROFILE_FIELDS & (1 << i)) || !(p->valid & (1 << i)))
+            continue;
+        if ((radio_now.valid & (1 << i)) && radio_now.value[i] == p->value[i])
+            continue;   // radio already there
+        if (!Xvtr_Profile_Write(i, p->value[i]))
+        {
+            DPRINTF("Xvtr_Profile_Enter: radio refused "); DPRINTLN(prof_cmd[i].name);
+        }
+        writes++;
+    }
+    radio_now.valid = 0;    // the operator or a CAT program can change it from here on
+    DPRINTF("Xvtr_Profile_Enter: "); DPRINT(bandmem[band].band_name); DPRINTF(" restored with "); DPRINT(writes); DPRINTLNF(" writes");
+    return writes;
+}
+
+void Xvtr_Profile_Clear(uint8_t band)
+{
+    if (band < BANDS)
+        radio_profile[band].valid = 0;
+}
+
+COLD void Xvtr_Profile_Show(uint8_t band)
+{
+    if (band >= BANDS)
+        return;
+    DPRINTF("Xvtr_Profile: "); DPRINTLN(bandmem[band].band_name);
+    for (uint8_t i = 0; i < PROF_FIELDS; i++)
+    {
+        DPRINTF("  "); DPRINT(prof_cmd[i].name); DPRINTF(": ");
+        if (radio_profile[band].valid & (1 << i))
+            DPRINT(radio_profile[band].value[i]);
+        else
+            DPRINTF("-");
+        if (!(XVTR_PROFILE_FIELDS & (1 << i)))
+            DPRINTF(" (disabled)");
+        DPRINTLNF("");
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef _XVTR_PROFILE_H_
+#define _XVTR_PROFILE_H_
+//
+//  Xvtr_Profile.h
+//
+//  Per transverter band radio profile.  Several transverter bands usually share one IF band on the radio, so
+//  settings the radio keeps per IF band (RF power, NB, NR) are read back on band exit and restored on band entry.
+//  Mode, filter and DATA already follow the band in bandmem[].  XVTR_PROFILE_FIELDS in RadioConfig.h picks the fields.
+//  Nothing is read or written with NO_SEND 1 or between two bands that are not transverter bands.
+//
+#include <Arduino.h>
+
+// Bit order matches XVTR_PROFILE_FIELDS
+enum Profile_Field {
+    PROF_RF_POWER,
+    PROF_RF_GAIN,
+    PROF_NB,
+    PROF_NB_LEVEL,
+    PROF_NR,
+    PROF_NR_LEVEL,
+    PROF_FIELDS
+};
+
+void Xvtr_Profile_Exit(uint8_t band, uint8_t next);    // read the radio's settings if either band is a transverter band, save them for band
+uint8_t Xvtr_Profile_Enter(uint8_t band);       // restore a transverter band's saved settings, returns the writes sent
+void Xvtr_Profile_Clear(uint8_t band);
+void Xvtr_Profile_Show(uint8_t band);           // the saved profile to the Debug port
+
+#endif // _XVTR_PROFILE_H_